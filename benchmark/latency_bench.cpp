@@ -0,0 +1,105 @@
+// BlazeCSV Single-Record Latency Benchmark
+//
+// Per-call latency of parse_record() on market-data-sized records, reported
+// as percentiles and a log2 histogram. Timer overhead is measured and shown
+// separately; it is included in every sample.
+
+#include <blazecsv/blazecsv.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr size_t RECORDS = 4096;
+constexpr size_t SAMPLES = 2'000'000;
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<std::string> generate_quotes() {
+    std::vector<std::string> quotes;
+    quotes.reserve(RECORDS);
+    const std::array<const char*, 4> symbols{"AAPL", "MSFT", "NVDA", "BRK.B"};
+    for (size_t i = 0; i < RECORDS; ++i) {
+        double bid = 100.0 + static_cast<double>(i % 500) / 100.0;
+        quotes.push_back(std::string(symbols[i % symbols.size()]) + "," + std::to_string(bid) +
+                         "," + std::to_string(bid + 0.01) + "," +
+                         std::to_string(100 * (i % 9 + 1)) + "," +
+                         std::to_string(1700000000000000000ULL + i * 1000) + "\n");
+    }
+    return quotes;
+}
+
+void report(const char* name, std::vector<int64_t>& ns) {
+    std::sort(ns.begin(), ns.end());
+    auto pct = [&](double p) { return ns[static_cast<size_t>(p * (ns.size() - 1))]; };
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << "p50 " << std::setw(5)
+              << pct(0.50) << " ns  p99 " << std::setw(5) << pct(0.99) << " ns  p999 "
+              << std::setw(6) << pct(0.999) << " ns  max " << ns.back() << " ns\n";
+}
+
+void histogram(const std::vector<int64_t>& sorted) {
+    std::array<size_t, 24> buckets{};
+    for (int64_t v : sorted) {
+        size_t b = 0;
+        while (b + 1 < buckets.size() && (int64_t{1} << (b + 1)) <= v)
+            ++b;
+        ++buckets[b];
+    }
+    std::cout << "\n  Histogram (parse_record):\n";
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        if (buckets[b] == 0)
+            continue;
+        double share = 100.0 * static_cast<double>(buckets[b]) / static_cast<double>(sorted.size());
+        std::cout << "    [" << std::setw(7) << (int64_t{1} << b) << ", " << std::setw(7)
+                  << (int64_t{1} << (b + 1)) << ") ns " << std::setw(8) << std::fixed
+                  << std::setprecision(4) << share << " %  "
+                  << std::string(static_cast<size_t>(share / 2), '#') << "\n";
+    }
+}
+
+template <typename Fn>
+std::vector<int64_t> sample(Fn&& fn) {
+    std::vector<int64_t> ns(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        auto start = Clock::now();
+        fn(i % RECORDS);
+        auto end = Clock::now();
+        ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+    return ns;
+}
+
+int main() {
+    std::cout << "=== BlazeCSV Single-Record Latency ===\n\n";
+    auto quotes = generate_quotes();
+    volatile double sink = 0;
+
+    auto timer = sample([&](size_t) {});
+    report("timer overhead", timer);
+
+    auto tokenize = sample([&](size_t i) {
+        auto r = blazecsv::parse_record<5>(quotes[i]);
+        sink = sink + static_cast<double>((*r)[1].size());
+    });
+    report("parse_record", tokenize);
+
+    auto convert = sample([&](size_t i) {
+        auto r = blazecsv::parse_record<5>(quotes[i]);
+        sink = sink + (*r)[1].value_or(0.0) + static_cast<double>((*r)[3].value_or(0));
+    });
+    report("parse_record + convert", convert);
+
+    auto reader = sample([&](size_t i) {
+        blazecsv::TurboReader<5> r{blazecsv::FileSource::borrowed(quotes[i]), false};
+        r.for_each([&](const auto& f) { sink = sink + static_cast<double>(f[1].size()); });
+    });
+    report("TurboReader (borrowed)", reader);
+
+    histogram(tokenize);
+    return 0;
+}
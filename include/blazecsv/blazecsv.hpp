@@ -58,21 +58,39 @@ inline unsigned blazecsv_ctz(unsigned mask) noexcept {
 #endif
 
 // Standard library
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
+#include <cerrno>
 #include <charconv>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <deque>
 #include <expected>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-// System headers for mmap
+// System headers for mmap / read
 #if defined(_WIN32)
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -88,6 +106,36 @@ inline unsigned blazecsv_ctz(unsigned mask) noexcept {
 #include <unistd.h>
 #endif
 
+// io_uring (Linux 5.6+) for batched small-file loading; define BLAZECSV_NO_IO_URING to disable
+#if defined(__linux__) && !defined(BLAZECSV_NO_IO_URING) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define BLAZECSV_HAS_IO_URING 1
+#endif
+
+// Compressed output codecs (opt-in, each needs its library linked)
+#ifdef BLAZECSV_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef BLAZECSV_WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef BLAZECSV_WITH_LZ4
+#include <lz4frame.h>
+#endif
+
+// USDT tracepoints for bpftrace/perf/SystemTap; define BLAZECSV_ENABLE_PROBES to compile them in.
+// A disabled probe is a single nop in the text section, so they cost nothing until attached.
+#if defined(BLAZECSV_ENABLE_PROBES) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define BLAZECSV_HAS_PROBES 1
+#define BLAZECSV_PROBE2(name, a, b) DTRACE_PROBE2(blazecsv, name, a, b)
+#define BLAZECSV_PROBE3(name, a, b, c) DTRACE_PROBE3(blazecsv, name, a, b, c)
+#else
+#define BLAZECSV_PROBE2(name, a, b) ((void)0)
+#define BLAZECSV_PROBE3(name, a, b, c) ((void)0)
+#endif
+
 namespace blazecsv {
 
 // =============================================================================
@@ -106,7 +154,12 @@ enum class ErrorCode : uint8_t {
     OutOfRange,
     ColumnCountMismatch,
     EndOfFile,
-    FileOpenError
+    FileOpenError,
+    FileWriteError,
+    CodecUnavailable,
+    DecompressError,
+    InvalidEnum,
+    ReadError
 };
 
 /// Lightweight error info - fixed size, no allocations
@@ -340,6 +393,243 @@ BLAZECSV_HOT inline size_t find_newline(const char* data, size_t len) noexcept {
     return len;
 }
 
+#if BLAZECSV_SIMD_NEON || BLAZECSV_SIMD_SSE2
+/// Bitmaps of the delimiters and of the LF/CR bytes among the 16 bytes at p.
+/// Byte i sets bit (i << BLOCK_BIT_SHIFT); NEON has no movemask, so its bytes
+/// are 4 bits apart.
+struct BlockMasks {
+    uint64_t delims;
+    uint64_t stops;
+};
+
+#if BLAZECSV_SIMD_NEON
+inline constexpr unsigned BLOCK_BIT_SHIFT = 2;
+
+BLAZECSV_HOT inline BlockMasks block_masks(const char* p, char delim) noexcept {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t d = vceqq_u8(chunk, vdupq_n_u8(static_cast<uint8_t>(delim)));
+    uint8x16_t t = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\n')), vceqq_u8(chunk, vdupq_n_u8('\r')));
+    auto nibbles = [](uint8x16_t m) {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0) &
+               0x8888888888888888ull;  // One bit per byte, so clearing the lowest bit pops a byte
+    };
+    return {nibbles(d), nibbles(t)};
+}
+#else
+inline constexpr unsigned BLOCK_BIT_SHIFT = 0;
+
+BLAZECSV_HOT inline BlockMasks block_masks(const char* p, char delim) noexcept {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i d = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(delim));
+    __m128i t = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')),
+                             _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')));
+    return {static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(d))),
+            static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(t)))};
+}
+#endif
+#endif
+
+/// Split one line (without its terminator) into at most `limit` fields,
+/// calling field(index, begin, end) for each in order. A delimiter right
+/// before the end yields a trailing empty field. Returns the number of fields.
+/// Both split_fields and WideReader tokenize through this loop.
+template <char Delim, typename FieldFn>
+BLAZECSV_HOT inline size_t for_each_field(const char* ptr, const char* effective_end, size_t limit,
+                                          FieldFn&& field) {
+    size_t col = 0;
+
+#if BLAZECSV_SIMD_NEON || BLAZECSV_SIMD_SSE2
+    // Every delimiter bit in a block closes a field, so a run of empty fields
+    // costs a bit each rather than a find_field_end call each. LF/CR inside
+    // the line and the last partial block are left to the loop below.
+    for (const char* block = ptr; col < limit && effective_end - block >= 16; block += 16) {
+        auto [delims, stops] = block_masks(block, Delim);
+        if (stops)
+            delims &= (stops & (0 - stops)) - 1;  // Only delimiters before the first stop
+        for (; delims && col < limit; delims &= delims - 1) {
+            const char* delim = block + (std::countr_zero(delims) >> BLOCK_BIT_SHIFT);
+            field(col++, ptr, delim);
+            ptr = delim + 1;
+        }
+        if (stops)
+            break;
+    }
+#endif
+
+    while (col < limit && ptr < effective_end) {
+        const char* start = ptr;
+        ptr += find_field_end(ptr, effective_end - ptr, Delim);
+        field(col++, start, ptr);
+        if (ptr < effective_end && *ptr == Delim)
+            ++ptr;
+    }
+
+    // Trailing empty field: the line ends with a delimiter that closed the last field
+    if (col > 0 && col < limit && ptr == effective_end && effective_end[-1] == Delim)
+        field(col++, ptr, ptr);
+
+    return col;
+}
+
+/// Split one line (without its terminator) into at most Columns fields.
+/// A delimiter right before the end yields a trailing empty field.
+/// Returns the number of fields found.
+template <size_t Columns, char Delim>
+BLAZECSV_HOT inline size_t split_fields(const char* ptr, const char* effective_end,
+                                        const char** starts, const char** ends) noexcept {
+    return for_each_field<Delim>(ptr, effective_end, Columns,
+                                 [&](size_t col, const char* begin, const char* end) {
+                                     starts[col] = begin;
+                                     ends[col] = end;
+                                 });
+}
+
+/// Terminator layout of the last tokenized line.
+///
+/// Machine-generated files (fixed-precision prices, zero-padded IDs) often put
+/// delimiters at the same offsets on every line. Each byte of a line is
+/// classified as delimiter / LF / CR / other; if the next line classifies
+/// identically over the remembered span, it tokenizes to the same offsets, so
+/// its fields are produced by one vector compare per 16 bytes instead of a
+/// find_newline plus one find_field_end per field. Repeated misses back off.
+template <size_t Columns, char Delim>
+class RowLayout {
+public:
+#if BLAZECSV_SIMD_NEON || BLAZECSV_SIMD_SSE2
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+    static constexpr size_t MAX_SPAN = 256;       // Longest line (including '\n') tracked
+    static constexpr unsigned MAX_MISSES = 8;     // Consecutive misses before backing off
+    static constexpr unsigned BACKOFF_ROWS = 1024;
+
+    /// On a hit, fills starts/ends, sets line_end (the '\n') and returns true
+    BLAZECSV_HOT bool match(const char* line, const char* end, const char** starts,
+                            const char** ends, size_t& col, const char*& line_end) noexcept {
+        if constexpr (enabled) {
+            if (backoff_) {
+                --backoff_;
+                return false;
+            }
+            if (span_ == 0 || static_cast<size_t>(end - line) < blocks_ * 16)
+                return false;
+
+            for (size_t b = 0; b + 1 < blocks_; ++b) {
+                if (!same_class(line + b * 16, classes_.data() + b * 16, nullptr))
+                    return miss();
+            }
+            const size_t last = (blocks_ - 1) * 16;
+            if (!same_class(line + last, classes_.data() + last, tail_mask_.data()))
+                return miss();
+
+            misses_ = 0;
+            for (size_t i = 0; i < cols_; ++i) {
+                starts[i] = line + start_offsets_[i];
+                ends[i] = line + end_offsets_[i];
+            }
+            col = cols_;
+            line_end = line + span_ - 1;
+            return true;
+        } else {
+            (void)line, (void)end, (void)starts, (void)ends, (void)col, (void)line_end;
+            return false;
+        }
+    }
+
+    /// Remember the layout of a line tokenized the regular way
+    void learn(const char* line, const char* line_end, const char* end, const char* const* starts,
+               const char* const* ends, size_t col) noexcept {
+        if constexpr (enabled) {
+            span_ = 0;
+            if (backoff_ || line_end >= end)  // Backing off, or last line has no '\n'
+                return;
+            const size_t span = static_cast<size_t>(line_end - line) + 1;
+            const size_t blocks = (span + 15) / 16;
+            if (span > MAX_SPAN || static_cast<size_t>(end - line) < blocks * 16)
+                return;
+
+            for (size_t b = 0; b < blocks; ++b)
+                store_class(line + b * 16, classes_.data() + b * 16);
+            const size_t tail = span - (blocks - 1) * 16;
+            for (size_t i = 0; i < 16; ++i)
+                tail_mask_[i] = i < tail ? 0xFF : 0;
+            for (size_t i = tail; i < 16; ++i)
+                classes_[(blocks - 1) * 16 + i] = 0;
+
+            for (size_t i = 0; i < col; ++i) {
+                start_offsets_[i] = static_cast<uint16_t>(starts[i] - line);
+                end_offsets_[i] = static_cast<uint16_t>(ends[i] - line);
+            }
+            cols_ = col;
+            blocks_ = blocks;
+            span_ = span;
+        } else {
+            (void)line, (void)line_end, (void)end, (void)starts, (void)ends, (void)col;
+        }
+    }
+
+private:
+    alignas(16) std::array<uint8_t, MAX_SPAN> classes_{};
+    alignas(16) std::array<uint8_t, 16> tail_mask_{};
+    std::array<uint16_t, Columns> start_offsets_{};
+    std::array<uint16_t, Columns> end_offsets_{};
+    size_t span_ = 0;  // 0 = nothing learned
+    size_t blocks_ = 0;
+    size_t cols_ = 0;
+    unsigned misses_ = 0;
+    unsigned backoff_ = 0;
+
+    bool miss() noexcept {
+        if (++misses_ >= MAX_MISSES) {
+            misses_ = 0;
+            backoff_ = BACKOFF_ROWS;
+        }
+        return false;
+    }
+
+#if BLAZECSV_SIMD_NEON
+    static uint8x16_t classify(const char* p) noexcept {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t d = vandq_u8(vceqq_u8(v, vdupq_n_u8(static_cast<uint8_t>(Delim))),
+                                vdupq_n_u8(1));
+        uint8x16_t n = vandq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vdupq_n_u8(2));
+        uint8x16_t c = vandq_u8(vceqq_u8(v, vdupq_n_u8('\r')), vdupq_n_u8(4));
+        return vorrq_u8(vorrq_u8(d, n), c);
+    }
+
+    static void store_class(const char* p, uint8_t* out) noexcept { vst1q_u8(out, classify(p)); }
+
+    static bool same_class(const char* p, const uint8_t* expected, const uint8_t* mask) noexcept {
+        uint8x16_t cls = classify(p);
+        if (mask)
+            cls = vandq_u8(cls, vld1q_u8(mask));
+        uint64x2_t diff = vreinterpretq_u64_u8(veorq_u8(cls, vld1q_u8(expected)));
+        return (vgetq_lane_u64(diff, 0) | vgetq_lane_u64(diff, 1)) == 0;
+    }
+#elif BLAZECSV_SIMD_SSE2
+    static __m128i classify(const char* p) noexcept {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i d = _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(Delim)), _mm_set1_epi8(1));
+        __m128i n = _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_set1_epi8(2));
+        __m128i c = _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_set1_epi8(4));
+        return _mm_or_si128(_mm_or_si128(d, n), c);
+    }
+
+    static void store_class(const char* p, uint8_t* out) noexcept {
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), classify(p));
+    }
+
+    static bool same_class(const char* p, const uint8_t* expected, const uint8_t* mask) noexcept {
+        __m128i cls = classify(p);
+        if (mask)
+            cls = _mm_and_si128(cls, _mm_load_si128(reinterpret_cast<const __m128i*>(mask)));
+        __m128i want = _mm_load_si128(reinterpret_cast<const __m128i*>(expected));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(cls, want)) == 0xFFFF;
+    }
+#endif
+};
+
 }  // namespace detail
 
 // =============================================================================
@@ -498,716 +788,5803 @@ public:
     [[nodiscard]] const char* data() const noexcept { return data_; }
     [[nodiscard]] size_t size() const noexcept { return size_; }
     [[nodiscard]] bool valid() const noexcept { return data_ != nullptr; }
+
+private:
+    friend class FileSource;
+    friend class MappedFileCache;
+
+#if !defined(_WIN32)
+    // Adopt an already-open descriptor whose size is known (FileSource fast path)
+    MmapSource(int fd, size_t size) : size_(size), fd_(fd) {
+        if (size_ > 0) {
+            data_ =
+                static_cast<const char*>(::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0));
+            if (data_ == MAP_FAILED) {
+                ::close(fd_);
+                fd_ = -1;
+                data_ = nullptr;
+                return;
+            }
+            ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+        }
+    }
+#endif
 };
 
 // =============================================================================
-// LIGHTWEIGHT FIELD REFERENCE (16 bytes only)
+// POOLED READ SOURCE - Small-file fast path (no mmap/munmap)
 // =============================================================================
 
-class FieldRef {
-    const char* begin_;
-    const char* end_;
+namespace detail {
 
+/// Per-thread free list of cache-line aligned buffers.
+/// Small files are read into recycled buffers, so steady-state parsing of many
+/// small files performs no allocation and no munmap (no TLB shootdowns).
+class BufferPool {
 public:
-    constexpr FieldRef() noexcept : begin_(nullptr), end_(nullptr) {}
-    constexpr FieldRef(const char* begin, const char* end) noexcept : begin_(begin), end_(end) {}
-
-    // --- Basic accessors (always inline) ---
-    [[nodiscard]] constexpr std::string_view view() const noexcept {
-        return {begin_, static_cast<size_t>(end_ - begin_)};
-    }
-    [[nodiscard]] constexpr const char* begin() const noexcept { return begin_; }
-    [[nodiscard]] constexpr const char* end() const noexcept { return end_; }
-    [[nodiscard]] constexpr size_t size() const noexcept { return end_ - begin_; }
-    [[nodiscard]] constexpr bool empty() const noexcept { return begin_ == end_; }
-
-    // --- Null check with policy ---
-    template <typename NullPol = NullStandard>
-    [[nodiscard]] constexpr bool is_null() const noexcept {
-        return NullPol::check(begin_, end_);
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t MAX_CACHED = 8;
+    static constexpr size_t MIN_CAPACITY = 64 * 1024;
+
+    struct Block {
+        char* data = nullptr;
+        size_t capacity = 0;
+    };
+
+    /// Pool of the calling thread
+    [[nodiscard]] static BufferPool& local() noexcept {
+        thread_local BufferPool pool;
+        return pool;
     }
 
-    // ==========================================================================
-    // TYPE PARSING - Returns std::expected (C++23, zero-overhead error handling)
-    // ==========================================================================
-
-    // --- Integer parsing (fastest path) ---
-    template <typename T>
-        requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
-    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
-        T value{};
-        auto [ptr, ec] = std::from_chars(begin_, end_, value);
-        if (ec == std::errc{} && ptr == end_) {
-            return value;
+    [[nodiscard]] Block acquire(size_t size) {
+        // Best fit among cached blocks
+        size_t best = count_;
+        for (size_t i = 0; i < count_; ++i) {
+            if (cached_[i].capacity >= size &&
+                (best == count_ || cached_[i].capacity < cached_[best].capacity))
+                best = i;
         }
-        return std::unexpected(ec == std::errc::result_out_of_range ? ErrorCode::OutOfRange
-                                                                    : ErrorCode::InvalidInteger);
+        if (best != count_) {
+            Block b = cached_[best];
+            cached_[best] = cached_[--count_];
+            return b;
+        }
+
+        size_t capacity = size < MIN_CAPACITY ? MIN_CAPACITY : (size + 4095) & ~size_t{4095};
+        auto* data = static_cast<char*>(::operator new(capacity, std::align_val_t{ALIGNMENT}));
+        return Block{data, capacity};
     }
 
-    // --- Floating point parsing ---
-    template <typename T>
-        requires std::is_floating_point_v<T>
-    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
-        T value{};
-        if (parse_double_fast(value)) {
-            return value;
-        }
-        // Fallback to strtod
-        char* endptr = nullptr;
-        if constexpr (std::is_same_v<T, float>) {
-            value = std::strtof(begin_, &endptr);
-        } else {
-            value = std::strtod(begin_, &endptr);
-        }
-        if (endptr == end_) {
-            return value;
+    /// Return a block to the calling thread's pool (frees it if the pool is full
+    /// or the thread's pool has already been destroyed)
+    static void release(Block b) noexcept {
+        if (!b.data)
+            return;
+        if (alive()) {
+            BufferPool& pool = local();
+            if (pool.count_ < MAX_CACHED) {
+                pool.cached_[pool.count_++] = b;
+                return;
+            }
         }
-        return std::unexpected(ErrorCode::InvalidFloat);
+        ::operator delete(b.data, std::align_val_t{ALIGNMENT});
     }
 
-    // --- Boolean parsing ---
-    template <typename T>
-        requires std::is_same_v<T, bool>
-    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
-        const size_t len = size();
-        if (len == 0)
-            return std::unexpected(ErrorCode::InvalidBool);
-
-        // Single character: 1/0, t/f, y/n
-        if (len == 1) {
-            char c = *begin_;
-            if (c == '1' || c == 't' || c == 'T' || c == 'y' || c == 'Y')
-                return true;
-            if (c == '0' || c == 'f' || c == 'F' || c == 'n' || c == 'N')
-                return false;
-        }
+    [[nodiscard]] size_t cached() const noexcept { return count_; }
 
-        // Full words
-        if (len == 4) {
-            if (std::memcmp(begin_, "true", 4) == 0 || std::memcmp(begin_, "True", 4) == 0 ||
-                std::memcmp(begin_, "TRUE", 4) == 0)
-                return true;
-        }
-        if (len == 5) {
-            if (std::memcmp(begin_, "false", 5) == 0 || std::memcmp(begin_, "False", 5) == 0 ||
-                std::memcmp(begin_, "FALSE", 5) == 0)
-                return false;
-        }
-        if (len == 3) {
-            if (std::memcmp(begin_, "yes", 3) == 0 || std::memcmp(begin_, "Yes", 3) == 0 ||
-                std::memcmp(begin_, "YES", 3) == 0)
-                return true;
-        }
-        if (len == 2) {
-            if (std::memcmp(begin_, "no", 2) == 0 || std::memcmp(begin_, "No", 2) == 0 ||
-                std::memcmp(begin_, "NO", 2) == 0)
-                return false;
-        }
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
 
-        return std::unexpected(ErrorCode::InvalidBool);
+private:
+    std::array<Block, MAX_CACHED> cached_{};
+    size_t count_ = 0;
+
+    BufferPool() noexcept { alive() = true; }
+    ~BufferPool() {
+        alive() = false;
+        for (size_t i = 0; i < count_; ++i)
+            ::operator delete(cached_[i].data, std::align_val_t{ALIGNMENT});
     }
 
-    // --- String (always succeeds) ---
-    template <typename T>
-        requires std::is_same_v<T, std::string_view>
-    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
-        return view();
+    // Trivially destructible, so it stays readable during thread teardown
+    static bool& alive() noexcept {
+        thread_local bool flag = false;
+        return flag;
     }
+};
 
-    template <typename T>
-        requires std::is_same_v<T, std::string>
-    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
-        return std::string(begin_, end_);
-    }
+/// RAII handle for a block borrowed from BufferPool
+class PooledBuffer {
+    BufferPool::Block block_{};
 
-    // --- Date parsing (YYYY-MM-DD) ---
-    [[nodiscard]] std::expected<std::chrono::year_month_day, ErrorCode> parse_date()
-        const noexcept {
-        if (size() < 10)
-            return std::unexpected(ErrorCode::InvalidDate);
+public:
+    PooledBuffer() = default;
+    explicit PooledBuffer(size_t size) : block_(BufferPool::local().acquire(size)) {}
+    ~PooledBuffer() { BufferPool::release(block_); }
 
-        int year, month, day;
-        auto [p1, e1] = std::from_chars(begin_, begin_ + 4, year);
-        if (e1 != std::errc{} || *(begin_ + 4) != '-')
-            return std::unexpected(ErrorCode::InvalidDate);
+    PooledBuffer(PooledBuffer&& o) noexcept : block_(std::exchange(o.block_, {})) {}
+    PooledBuffer& operator=(PooledBuffer&& o) noexcept {
+        if (this != &o) {
+            BufferPool::release(block_);
+            block_ = std::exchange(o.block_, {});
+        }
+        return *this;
+    }
 
-        auto [p2, e2] = std::from_chars(begin_ + 5, begin_ + 7, month);
-        if (e2 != std::errc{} || *(begin_ + 7) != '-')
-            return std::unexpected(ErrorCode::InvalidDate);
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
 
-        auto [p3, e3] = std::from_chars(begin_ + 8, begin_ + 10, day);
-        if (e3 != std::errc{})
-            return std::unexpected(ErrorCode::InvalidDate);
+    [[nodiscard]] char* data() const noexcept { return block_.data; }
+    [[nodiscard]] size_t capacity() const noexcept { return block_.capacity; }
+};
 
-        auto ymd = std::chrono::year{year} / std::chrono::month{static_cast<unsigned>(month)} /
-                   std::chrono::day{static_cast<unsigned>(day)};
+}  // namespace detail
 
-        if (!ymd.ok())
-            return std::unexpected(ErrorCode::InvalidDate);
-        return ymd;
-    }
+/// Whole-file read into a pooled, aligned buffer.
+/// open + fstat + read + close: no mapping to build or tear down.
+class ReadSource {
+    detail::PooledBuffer buffer_;
+    size_t size_ = 0;
 
-    // --- DateTime parsing (YYYY-MM-DD HH:MM:SS or YYYY-MM-DDTHH:MM:SS) ---
-    [[nodiscard]] std::expected<std::chrono::system_clock::time_point, ErrorCode> parse_datetime()
-        const noexcept {
-        if (size() < 19)
-            return std::unexpected(ErrorCode::InvalidDateTime);
+public:
+    ReadSource() = default;
 
-        auto date_result = parse_date();
-        if (!date_result)
-            return std::unexpected(date_result.error());
+    explicit ReadSource(const std::string& path) {
+#if defined(_WIN32)
+        HANDLE h = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (h == INVALID_HANDLE_VALUE)
+            return;
+        LARGE_INTEGER file_size;
+        if (GetFileSizeEx(h, &file_size))
+            load(h, static_cast<size_t>(file_size.QuadPart));
+        CloseHandle(h);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0)
+            load(fd, static_cast<size_t>(st.st_size));
+        ::close(fd);
+#endif
+    }
 
-        char sep = *(begin_ + 10);
-        if (sep != ' ' && sep != 'T')
-            return std::unexpected(ErrorCode::InvalidDateTime);
+    [[nodiscard]] const char* data() const noexcept { return size_ ? buffer_.data() : nullptr; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool valid() const noexcept { return data() != nullptr; }
 
-        int hour, minute, second;
-        auto [p1, e1] = std::from_chars(begin_ + 11, begin_ + 13, hour);
-        if (e1 != std::errc{} || *(begin_ + 13) != ':')
-            return std::unexpected(ErrorCode::InvalidDateTime);
+private:
+    friend class FileSource;
+    friend class FileBatchSource;
 
-        auto [p2, e2] = std::from_chars(begin_ + 14, begin_ + 16, minute);
-        if (e2 != std::errc{} || *(begin_ + 16) != ':')
-            return std::unexpected(ErrorCode::InvalidDateTime);
+    // Adopt a buffer already filled by the caller (FileBatchSource)
+    ReadSource(detail::PooledBuffer&& buffer, size_t size)
+        : buffer_(std::move(buffer)), size_(size) {}
 
-        auto [p3, e3] = std::from_chars(begin_ + 17, begin_ + 19, second);
-        if (e3 != std::errc{})
-            return std::unexpected(ErrorCode::InvalidDateTime);
+#if defined(_WIN32)
+    void load(HANDLE h, size_t size) {
+        if (size == 0)
+            return;
+        buffer_ = detail::PooledBuffer(size);
+        size_t total = 0;
+        while (total < size) {
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(size - total, 1u << 30));
+            DWORD got = 0;
+            if (!ReadFile(h, buffer_.data() + total, chunk, &got, nullptr) || got == 0)
+                return fail();
+            total += got;
+        }
+        size_ = total;
+    }
+#else
+    void load(int fd, size_t size) {
+        if (size == 0)
+            return;
+        buffer_ = detail::PooledBuffer(size);
+        size_t total = 0;
+        while (total < size) {
+            ssize_t got = ::pread(fd, buffer_.data() + total, size - total,
+                                  static_cast<off_t>(total));
+            if (got < 0 && errno == EINTR)
+                continue;
+            if (got <= 0)
+                return fail();  // I/O error, or the file shrank since it was sized
+            total += static_cast<size_t>(got);
+        }
+        size_ = total;
+    }
+#endif
 
-        if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60)
-            return std::unexpected(ErrorCode::InvalidDateTime);
+    // A partial read is never handed out as the whole file
+    void fail() noexcept {
+        buffer_ = detail::PooledBuffer();
+        size_ = 0;
+    }
+};
 
-        auto tp = std::chrono::sys_days{*date_result} + std::chrono::hours{hour} +
-                  std::chrono::minutes{minute} + std::chrono::seconds{second};
+// =============================================================================
+// FILE SOURCE - read() below a size threshold, mmap above it
+// =============================================================================
 
-        return std::chrono::time_point_cast<std::chrono::system_clock::duration>(tp);
+class FileSource {
+    MmapSource mmap_;
+    ReadSource read_;
+    std::shared_ptr<const MmapSource> shared_;  // Mapping owned with other sources
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool opened_ = false;
+
+public:
+    /// Files up to this size are read into a pooled buffer instead of mapped
+    static constexpr size_t DEFAULT_READ_THRESHOLD = 256 * 1024;
+
+    FileSource() = default;
+
+    explicit FileSource(const std::string& path, size_t read_threshold = DEFAULT_READ_THRESHOLD) {
+#if defined(_WIN32)
+        WIN32_FILE_ATTRIBUTE_DATA attrs;
+        if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attrs))
+            return;
+        size_t file_size = (static_cast<size_t>(attrs.nFileSizeHigh) << 32) | attrs.nFileSizeLow;
+        if (file_size <= read_threshold) {
+            read_ = ReadSource(path);
+        } else {
+            mmap_ = MmapSource(path);
+        }
+        opened_ = file_size == 0 || read_.valid() || mmap_.valid();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            ::close(fd);
+            return;
+        }
+        size_t file_size = static_cast<size_t>(st.st_size);
+        if (file_size <= read_threshold) {
+            read_.load(fd, file_size);
+            ::close(fd);
+        } else {
+            mmap_ = MmapSource(fd, file_size);  // Takes ownership of fd
+        }
+        opened_ = file_size == 0 || read_.valid() || mmap_.valid();
+#endif
+        bind();
+        BLAZECSV_PROBE3(file_open, path.c_str(), file_size, mmap_.valid());
     }
 
-    // ==========================================================================
-    // CONVENIENCE METHODS
-    // ==========================================================================
+    explicit FileSource(MmapSource&& source) : mmap_(std::move(source)) {
+        bind();
+        opened_ = true;
+    }
+    explicit FileSource(ReadSource&& source) : read_(std::move(source)) {
+        bind();
+        opened_ = true;
+    }
 
-    /// Parse with default value on failure
-    template <typename T>
-    [[nodiscard]] T value_or(T default_value) const noexcept {
-        auto result = parse<T>();
-        return result ? *result : default_value;
+    /// View of a mapping shared with other sources; see MappedFileCache
+    explicit FileSource(std::shared_ptr<const MmapSource> mapping) : shared_(std::move(mapping)) {
+        bind();
+        opened_ = shared_ != nullptr;
     }
 
-    /// Parse as optional (null-aware)
-    template <typename T, typename NullPol = NullStandard>
-    [[nodiscard]] std::optional<T> as_optional() const noexcept {
-        if (is_null<NullPol>())
+    /// The file's mapping from MappedFileCache::global(), shared by every
+    /// source opened this way while the file is unchanged
+    [[nodiscard]] static FileSource shared(const std::string& path);
+
+    /// Non-owning source over caller memory; `data` must outlive any reader using it
+    [[nodiscard]] static FileSource borrowed(std::string_view data) noexcept {
+        FileSource source;
+        source.data_ = data.data();
+        source.size_ = data.size();
+        source.opened_ = true;
+        return source;
+    }
+
+    FileSource(FileSource&& o) noexcept
+        : mmap_(std::move(o.mmap_)),
+          read_(std::move(o.read_)),
+          shared_(std::move(o.shared_)),
+          data_(std::exchange(o.data_, nullptr)),
+          size_(std::exchange(o.size_, 0)),
+          opened_(std::exchange(o.opened_, false)) {}
+
+    FileSource& operator=(FileSource&& o) noexcept {
+        if (this != &o) {
+            mmap_ = std::move(o.mmap_);
+            read_ = std::move(o.read_);
+            shared_ = std::move(o.shared_);
+            data_ = std::exchange(o.data_, nullptr);
+            size_ = std::exchange(o.size_, 0);
+            opened_ = std::exchange(o.opened_, false);
+        }
+        return *this;
+    }
+
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+
+    [[nodiscard]] const char* data() const noexcept { return data_; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool valid() const noexcept { return data_ != nullptr; }
+    [[nodiscard]] bool is_mapped() const noexcept { return mmap_.valid() || is_shared(); }
+    /// True if the mapping is shared through MappedFileCache
+    [[nodiscard]] bool is_shared() const noexcept { return shared_ && shared_->valid(); }
+    /// True if the file was opened and sized (an empty file is opened but not valid())
+    [[nodiscard]] bool opened() const noexcept { return opened_; }
+
+private:
+    friend class FileBatchSource;
+
+    void bind() noexcept {
+        if (read_.valid()) {
+            data_ = read_.data();
+            size_ = read_.size();
+        } else if (shared_) {
+            data_ = shared_->data();
+            size_ = shared_->size();
+        } else {
+            data_ = mmap_.data();
+            size_ = mmap_.size();
+        }
+    }
+};
+
+// =============================================================================
+// MAPPED FILE CACHE - One mapping per file per process, shared by readers
+// =============================================================================
+
+/// Hands out shared, read-only mappings keyed by file identity (device,
+/// inode, size, mtime), so every reader of the same file in a process uses
+/// one mapping: repeat opens skip mmap and page faults, and page tables and
+/// address space are not duplicated. Entries are weak; a mapping is unmapped
+/// when its last user lets go. A file that was modified gets a new key and
+/// thus a fresh mapping. Thread-safe.
+class MappedFileCache {
+public:
+    /// Process-wide instance used by FileSource::shared()
+    static MappedFileCache& global() {
+        static MappedFileCache cache;
+        return cache;
+    }
+
+    /// Shared mapping of `path`; nullptr if it cannot be opened or mapped
+    [[nodiscard]] std::shared_ptr<const MmapSource> acquire(const std::string& path) {
+        Key key{};
+#if defined(_WIN32)
+        HANDLE h = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (h == INVALID_HANDLE_VALUE)
+            return nullptr;
+        BY_HANDLE_FILE_INFORMATION info;
+        const bool stat_ok = GetFileInformationByHandle(h, &info);
+        CloseHandle(h);
+        if (!stat_ok)
+            return nullptr;
+        key.device = info.dwVolumeSerialNumber;
+        key.inode = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        key.size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        key.mtime = (static_cast<uint64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+                    info.ftLastWriteTime.dwLowDateTime;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return nullptr;
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        key.device = static_cast<uint64_t>(st.st_dev);
+        key.inode = static_cast<uint64_t>(st.st_ino);
+        key.size = static_cast<uint64_t>(st.st_size);
+#if defined(__APPLE__)
+        key.mtime = static_cast<uint64_t>(st.st_mtimespec.tv_sec) * 1000000000u +
+                    static_cast<uint64_t>(st.st_mtimespec.tv_nsec);
+#else
+        key.mtime = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000u +
+                    static_cast<uint64_t>(st.st_mtim.tv_nsec);
+#endif
+#endif
+
+        std::lock_guard lock(mutex_);
+        if (auto it = entries_.find(key); it != entries_.end()) {
+            if (auto live = it->second.lock()) {
+                ++hits_;
+#if !defined(_WIN32)
+                ::close(fd);
+#endif
+                return live;
+            }
+        }
+        ++misses_;
+        std::erase_if(entries_, [](const auto& entry) { return entry.second.expired(); });
+
+#if defined(_WIN32)
+        auto mapping = std::make_shared<const MmapSource>(path);
+#else
+        std::shared_ptr<const MmapSource> mapping(
+            new MmapSource(fd, static_cast<size_t>(key.size)));
+#endif
+        if (key.size > 0 && !mapping->valid())
+            return nullptr;
+        entries_[key] = mapping;
+        return mapping;
+    }
+
+    /// FileSource over the shared mapping of `path`
+    [[nodiscard]] FileSource open(const std::string& path) { return FileSource(acquire(path)); }
+
+    /// Files currently mapped through the cache
+    [[nodiscard]] size_t size() const {
+        std::lock_guard lock(mutex_);
+        return static_cast<size_t>(std::count_if(
+            entries_.begin(), entries_.end(), [](const auto& e) { return !e.second.expired(); }));
+    }
+
+    [[nodiscard]] size_t hits() const {
+        std::lock_guard lock(mutex_);
+        return hits_;
+    }
+    [[nodiscard]] size_t misses() const {
+        std::lock_guard lock(mutex_);
+        return misses_;
+    }
+
+private:
+    struct Key {
+        uint64_t device;
+        uint64_t inode;
+        uint64_t size;
+        uint64_t mtime;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const noexcept {
+            uint64_t h = k.inode * 0x9E3779B97F4A7C15ull;
+            h ^= k.device + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= k.size + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= k.mtime + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::weak_ptr<const MmapSource>, KeyHash> entries_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+inline FileSource FileSource::shared(const std::string& path) {
+    return MappedFileCache::global().open(path);
+}
+
+// =============================================================================
+// FILE BATCH SOURCE - Many small files per syscall round-trip (io_uring)
+// =============================================================================
+
+namespace detail {
+
+/// Minimal multi-producer / multi-consumer bounded queue
+template <typename T>
+class BoundedQueue {
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<T> items_;
+    size_t capacity_;
+    bool closed_ = false;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+    void push(T item) {
+        std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this] { return items_.size() < capacity_ || closed_; });
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+    }
+
+    /// Blocks until an item is available; returns nullopt once closed and drained
+    std::optional<T> pop() {
+        std::unique_lock lock(mutex_);
+        not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+        if (items_.empty())
             return std::nullopt;
-        auto result = parse<T>();
-        return result ? std::optional<T>{*result} : std::nullopt;
+        T item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return item;
     }
 
-    /// Direct access for v1-compatible fast parsing
+    void close() {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+};
+
+#if BLAZECSV_HAS_IO_URING
+/// Bare-bones io_uring instance (raw syscalls, no liburing dependency)
+class IoUring {
+    int fd_ = -1;
+    unsigned sq_entries_ = 0;
+    unsigned sq_tail_local_ = 0;
+    unsigned sq_submitted_ = 0;
+
+    void* sq_ring_ = MAP_FAILED;
+    void* cq_ring_ = MAP_FAILED;
+    io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sq_ring_len_ = 0;
+    size_t cq_ring_len_ = 0;
+    size_t sqes_len_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+
     template <typename T>
-    [[nodiscard]] T as() const {
-        auto result = parse<T>();
-        return result.value_or(T{});
+    static T* at(void* base, unsigned offset) noexcept {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+    }
+
+public:
+    explicit IoUring(unsigned entries) {
+        io_uring_params params{};
+        int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0)
+            return;  // ENOSYS, EPERM (seccomp), ...
+        fd_ = fd;
+        sq_entries_ = params.sq_entries;
+
+        sq_ring_len_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_len_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap)
+            sq_ring_len_ = cq_ring_len_ = std::max(sq_ring_len_, cq_ring_len_);
+
+        sq_ring_ = ::mmap(nullptr, sq_ring_len_, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == MAP_FAILED) {
+            reset();
+            return;
+        }
+        cq_ring_ = single_mmap ? sq_ring_
+                               : ::mmap(nullptr, cq_ring_len_, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            reset();
+            return;
+        }
+        sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_POPULATE, fd_,
+                                                   IORING_OFF_SQES));
+        if (sqes_ == MAP_FAILED) {
+            reset();
+            return;
+        }
+
+        sq_head_ = at<unsigned>(sq_ring_, params.sq_off.head);
+        sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+        sq_mask_ = at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+        sq_array_ = at<unsigned>(sq_ring_, params.sq_off.array);
+        cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+        cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+        cq_mask_ = at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+        cqes_ = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+        sq_tail_local_ = sq_submitted_ = *sq_tail_;
+    }
+
+    ~IoUring() { reset(); }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return fd_ >= 0; }
+    [[nodiscard]] unsigned capacity() const noexcept { return sq_entries_; }
+
+    /// Next free submission entry (zeroed), or nullptr if the SQ is full
+    [[nodiscard]] io_uring_sqe* next_sqe() noexcept {
+        unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        if (sq_tail_local_ - head >= sq_entries_)
+            return nullptr;
+        unsigned idx = sq_tail_local_ & *sq_mask_;
+        sq_array_[idx] = idx;
+        ++sq_tail_local_;
+        std::memset(&sqes_[idx], 0, sizeof(io_uring_sqe));
+        return &sqes_[idx];
+    }
+
+#ifdef BLAZECSV_TESTING
+    /// Fault injection for tests: the calling thread's io_uring_enter call
+    /// with this index (0 = the next one) submits its entries, then reports
+    /// EIO. Negative disables it. Compiled in only with BLAZECSV_TESTING.
+    static inline thread_local int inject_enter_failure = -1;
+#endif
+
+    /// Submit queued entries and reap `count` completions through `on_complete`.
+    /// On an enter error, entries the kernel never took are dropped and every
+    /// entry it did take is still waited for and reaped, so no completion can
+    /// land in the caller's buffers after this returns; then returns false.
+    template <typename OnComplete>
+    [[nodiscard]] bool submit_and_wait(unsigned count, OnComplete&& on_complete) {
+        std::atomic_ref<unsigned>(*sq_tail_).store(sq_tail_local_, std::memory_order_release);
+        bool failed = false;
+        while (count > 0) {
+            unsigned to_submit = sq_tail_local_ - sq_submitted_;
+            long ret = enter(to_submit, failed ? 1 : count);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                    continue;
+                if (!failed) {
+                    // Withdraw what was not submitted; its completions will never come
+                    failed = true;
+                    count -= sq_tail_local_ - sq_submitted_;
+                    sq_tail_local_ = sq_submitted_;
+                    std::atomic_ref<unsigned>(*sq_tail_).store(sq_tail_local_,
+                                                                std::memory_order_release);
+                }
+                std::this_thread::yield();  // Completions still arrive without enter
+            } else {
+                sq_submitted_ += static_cast<unsigned>(ret);
+            }
+
+            unsigned head = *cq_head_;
+            unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            while (head != tail && count > 0) {
+                on_complete(cqes_[head & *cq_mask_]);
+                ++head;
+                --count;
+            }
+            std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+        }
+        return !failed;
     }
 
 private:
-    template <typename T>
-    bool parse_double_fast(T& x) const noexcept {
-        static_assert(std::is_floating_point_v<T>);
-        const char* p = begin_;
-        if (p >= end_)
+    long enter(unsigned to_submit, unsigned min_complete) noexcept {
+#ifdef BLAZECSV_TESTING
+        if (inject_enter_failure >= 0 && inject_enter_failure-- == 0) {
+            long ret = ::syscall(__NR_io_uring_enter, fd_, to_submit, 0, 0, nullptr, 0);
+            if (ret > 0)
+                sq_submitted_ += static_cast<unsigned>(ret);
+            errno = EIO;
+            return -1;
+        }
+#endif
+        return ::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete,
+                         IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+
+    void reset() noexcept {
+        if (sqes_ != MAP_FAILED)
+            ::munmap(sqes_, sqes_len_);
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+            ::munmap(cq_ring_, cq_ring_len_);
+        if (sq_ring_ != MAP_FAILED)
+            ::munmap(sq_ring_, sq_ring_len_);
+        if (fd_ >= 0)
+            ::close(fd_);
+        sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+        sq_ring_ = cq_ring_ = MAP_FAILED;
+        fd_ = -1;
+    }
+};
+#endif
+
+}  // namespace detail
+
+/// Loads many (small) files with batched I/O and hands each one to a callback.
+///
+/// On Linux with io_uring, each batch costs two submissions: openat + statx for
+/// every file, then hard-linked read -> close chains sized from statx. Files
+/// above `read_threshold` are mapped individually; without io_uring every file
+/// goes through FileSource.
+class FileBatchSource {
+    std::vector<std::string> paths_;
+    size_t batch_size_;
+    size_t read_threshold_;
+    std::atomic<size_t> failed_{0};
+
+    // Buffers recycled between batches (workers give them back after parsing)
+    std::mutex stash_mutex_;
+    std::vector<detail::PooledBuffer> stash_;
+
+    struct Loaded {
+        size_t index = 0;
+        FileSource source;
+    };
+
+public:
+    static constexpr size_t DEFAULT_BATCH_SIZE = 128;
+
+    explicit FileBatchSource(std::vector<std::string> paths,
+                             size_t batch_size = DEFAULT_BATCH_SIZE,
+                             size_t read_threshold = FileSource::DEFAULT_READ_THRESHOLD)
+        : paths_(std::move(paths)),
+          batch_size_(batch_size ? batch_size : 1),
+          read_threshold_(read_threshold) {}
+
+    [[nodiscard]] const std::vector<std::string>& paths() const noexcept { return paths_; }
+
+    /// Files that could not be opened or read during the last pass
+    [[nodiscard]] size_t failed() const noexcept { return failed_.load(); }
+
+    /// Whether batched io_uring submission is available on this system
+    [[nodiscard]] static bool io_uring_available() noexcept {
+#if BLAZECSV_HAS_IO_URING
+        static const bool available = detail::IoUring(4).valid();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    /// Sequential delivery in path order
+    /// Callback: void(size_t path_index, std::string_view contents)
+    /// `contents` is valid only for the duration of the call (the buffer is recycled)
+    template <typename Callback>
+    size_t for_each_file(Callback&& callback) {
+        size_t delivered = 0;
+        load([&](Loaded&& file) {
+            deliver(file, callback);
+            ++delivered;
+        });
+        return delivered;
+    }
+
+    /// Loading on the calling thread overlaps with parsing on `num_threads` workers
+    /// Note: Callback may be invoked from multiple threads, in any file order!
+    template <typename Callback>
+    size_t for_each_file_parallel(Callback&& callback, size_t num_threads = 4) {
+        if (num_threads == 0)
+            num_threads = 1;
+        detail::BoundedQueue<Loaded> queue(batch_size_ + num_threads);
+        std::atomic<size_t> delivered{0};
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            workers.emplace_back([&]() {
+                while (auto file = queue.pop()) {
+                    deliver(*file, callback);
+                    delivered.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        load([&](Loaded&& file) { queue.push(std::move(file)); });
+        queue.close();
+        for (auto& w : workers)
+            w.join();
+        return delivered.load();
+    }
+
+private:
+    template <typename Callback>
+    void deliver(Loaded& file, Callback& callback) {
+        callback(file.index, std::string_view(file.source.data() ? file.source.data() : "",
+                                              file.source.size()));
+        if (file.source.read_.valid()) {
+            std::lock_guard lock(stash_mutex_);
+            stash_.push_back(std::move(file.source.read_.buffer_));
+        }
+    }
+
+    detail::PooledBuffer acquire(size_t size) {
+        {
+            std::lock_guard lock(stash_mutex_);
+            for (size_t i = 0; i < stash_.size(); ++i) {
+                if (stash_[i].capacity() >= size) {
+                    detail::PooledBuffer b = std::move(stash_[i]);
+                    stash_[i] = std::move(stash_.back());
+                    stash_.pop_back();
+                    return b;
+                }
+            }
+        }
+        return detail::PooledBuffer(size);
+    }
+
+    Loaded load_one(size_t index) {
+        FileSource source(paths_[index], read_threshold_);
+        if (!source.opened())
+            failed_.fetch_add(1, std::memory_order_relaxed);
+        return Loaded{index, std::move(source)};
+    }
+
+    template <typename Sink>
+    void load(Sink&& sink) {
+        failed_.store(0);
+#if BLAZECSV_HAS_IO_URING
+        detail::IoUring ring(static_cast<unsigned>(2 * batch_size_));
+        if (ring.valid()) {
+            const size_t batch = std::min<size_t>(batch_size_, ring.capacity() / 2);
+            size_t first = 0;
+            while (first < paths_.size()) {
+                const size_t count = std::min(batch, paths_.size() - first);
+                const bool ok = load_batch(ring, first, count, sink);
+                first += count;
+                if (!ok)
+                    break;  // The ring is unreliable: finish with plain reads
+            }
+            for (; first < paths_.size(); ++first)
+                sink(load_one(first));
+            return;
+        }
+#endif
+        for (size_t i = 0; i < paths_.size(); ++i)
+            sink(load_one(i));
+    }
+
+#if BLAZECSV_HAS_IO_URING
+    /// Load paths [first, first + count) and deliver them all; returns false
+    /// if the ring failed, in which case the batch was loaded with load_one
+    template <typename Sink>
+    bool load_batch(detail::IoUring& ring, size_t first, size_t count, Sink& sink) {
+        struct Slot {
+            int open_res = -1;
+            int stat_res = -1;
+            int read_res = -1;
+            struct statx stx {};
+            detail::PooledBuffer buffer;
+            bool queued = false;
+            bool closed = false;
+        };
+        std::vector<Slot> slots(count);
+
+        // submit_and_wait has reaped everything in flight, so only descriptors
+        // whose close never ran are left to release
+        auto fall_back = [&] {
+            for (size_t i = 0; i < count; ++i) {
+                if (slots[i].open_res >= 0 && !slots[i].closed)
+                    ::close(slots[i].open_res);
+                sink(load_one(first + i));
+            }
             return false;
+        };
+
+        // Phase 1: openat + statx for every file in the batch
+        for (size_t i = 0; i < count; ++i) {
+            const char* path = paths_[first + i].c_str();
+            io_uring_sqe* open_sqe = ring.next_sqe();
+            open_sqe->opcode = IORING_OP_OPENAT;
+            open_sqe->fd = AT_FDCWD;
+            open_sqe->addr = reinterpret_cast<uint64_t>(path);
+            open_sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            open_sqe->user_data = i << 1;
+
+            io_uring_sqe* stat_sqe = ring.next_sqe();
+            stat_sqe->opcode = IORING_OP_STATX;
+            stat_sqe->fd = AT_FDCWD;
+            stat_sqe->addr = reinterpret_cast<uint64_t>(path);
+            stat_sqe->len = STATX_SIZE;
+            stat_sqe->off = reinterpret_cast<uint64_t>(&slots[i].stx);
+            stat_sqe->user_data = (i << 1) | 1;
+        }
+        if (!ring.submit_and_wait(static_cast<unsigned>(2 * count), [&](const io_uring_cqe& cqe) {
+                Slot& slot = slots[cqe.user_data >> 1];
+                (cqe.user_data & 1 ? slot.stat_res : slot.open_res) = cqe.res;
+            }))
+            return fall_back();
+
+        // Phase 2: read -> close, hard-linked so the close runs even if the read fails
+        unsigned pending = 0;
+        for (size_t i = 0; i < count; ++i) {
+            Slot& slot = slots[i];
+            if (slot.open_res < 0)
+                continue;
+            const size_t size = slot.stat_res == 0 ? slot.stx.stx_size : 0;
+            const bool readable = slot.stat_res == 0 && size > 0 && size <= read_threshold_ &&
+                                  size <= std::numeric_limits<uint32_t>::max();
+
+            if (readable) {
+                slot.buffer = acquire(size);
+                io_uring_sqe* read_sqe = ring.next_sqe();
+                read_sqe->opcode = IORING_OP_READ;
+                read_sqe->fd = slot.open_res;
+                read_sqe->addr = reinterpret_cast<uint64_t>(slot.buffer.data());
+                read_sqe->len = static_cast<uint32_t>(size);
+                read_sqe->flags = IOSQE_IO_HARDLINK;
+                read_sqe->user_data = i << 1;
+                slot.queued = true;
+                ++pending;
+            }
+            io_uring_sqe* close_sqe = ring.next_sqe();
+            close_sqe->opcode = IORING_OP_CLOSE;
+            close_sqe->fd = slot.open_res;
+            close_sqe->user_data = (i << 1) | 1;
+            ++pending;
+        }
+        if (!ring.submit_and_wait(pending, [&](const io_uring_cqe& cqe) {
+                Slot& slot = slots[cqe.user_data >> 1];
+                if (cqe.user_data & 1)
+                    slot.closed = true;
+                else
+                    slot.read_res = cqe.res;
+            }))
+            return fall_back();
+
+        for (size_t i = 0; i < count; ++i) {
+            Slot& slot = slots[i];
+            const size_t index = first + i;
+            if (slot.open_res == -EINVAL || slot.open_res == -EOPNOTSUPP) {
+                sink(load_one(index));  // Kernel predates IORING_OP_OPENAT
+            } else if (slot.open_res < 0 || (slot.queued && slot.read_res < 0)) {
+                failed_.fetch_add(1, std::memory_order_relaxed);
+                sink(Loaded{index, FileSource{}});
+            } else if (slot.queued && static_cast<size_t>(slot.read_res) != slot.stx.stx_size) {
+                sink(load_one(index));  // Short read: the file changed, read it again whole
+            } else if (slot.queued) {
+                ReadSource read(std::move(slot.buffer), static_cast<size_t>(slot.read_res));
+                sink(Loaded{index, FileSource(std::move(read))});
+            } else if (slot.stat_res == 0 && slot.stx.stx_size == 0) {
+                sink(Loaded{index, FileSource{}});  // Empty file
+            } else {
+                sink(load_one(index));  // Too large to read: map it
+            }
+        }
+        return true;
+    }
+#endif
+};
 
-        bool negative = false;
-        if (*p == '-') {
-            negative = true;
-            ++p;
-        } else if (*p == '+') {
-            ++p;
+// =============================================================================
+// ENUM MAPPING - Compile-time perfect hash for categorical columns
+// =============================================================================
+
+/// Specialize with the (name, value) pairs of an enum to enable
+/// FieldRef::parse_enum<E>():
+///
+///     template <> struct blazecsv::enum_table<Side> {
+///         static constexpr std::pair<std::string_view, Side> entries[] = {
+///             {"BUY", Side::Buy}, {"SELL", Side::Sell}};
+///     };
+template <typename E>
+struct enum_table;
+
+template <typename E>
+concept MappedEnum = std::is_enum_v<E> && requires { std::size(enum_table<E>::entries); };
+
+namespace detail {
+
+template <typename T>
+constexpr T load_le(const char* p) noexcept {
+    if consteval {
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            value |= static_cast<T>(static_cast<uint8_t>(p[i])) << (8 * i);
+        return value;
+    } else {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big)
+            value = std::byteswap(value);
+        return value;
+    }
+}
+
+/// A string's first and last 8 bytes, read with fixed-size loads that never
+/// leave [p, p + len). Together with the length they identify strings of up
+/// to 16 bytes exactly; longer strings also fold the bytes in between into
+/// `middle` so names differing only there still hash apart.
+struct EnumWords {
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    uint64_t middle = 0;
+
+    constexpr EnumWords(const char* p, size_t len) noexcept {
+        if (len >= 8) {
+            head = load_le<uint64_t>(p);
+            tail = load_le<uint64_t>(p + len - 8);
+        } else if (len >= 4) {
+            head = load_le<uint32_t>(p) | (uint64_t{load_le<uint32_t>(p + len - 4)} << 32);
+        } else if (len > 0) {
+            head = static_cast<uint8_t>(p[0]) | (uint64_t{static_cast<uint8_t>(p[len / 2])} << 8) |
+                   (uint64_t{static_cast<uint8_t>(p[len - 1])} << 16);
+        }
+        // 8-byte words covering [8, len - 8); the last one may overlap head or tail
+        for (size_t offset = 8; offset + 8 < len; offset += 8) {
+            const uint64_t word = load_le<uint64_t>(p + std::min(offset, len - 16));
+            middle = (std::rotl(middle, 23) ^ word) * 0xFF51AFD7ED558CCDull;
+        }
+    }
+
+    [[nodiscard]] constexpr uint64_t key(size_t len) const noexcept {
+        return head ^ std::rotl(tail, 29) ^ std::rotl(middle, 47) ^
+               (len * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+/// Multiplicative perfect hash over enum_table<E>, found at compile time in
+/// the smallest power-of-two table that admits one: slot = (key * multiplier)
+/// >> shift. A lookup is a few integer loads, one multiply, one table load and
+/// one verification compare.
+template <MappedEnum E>
+class EnumHash {
+    static constexpr auto& entries = enum_table<E>::entries;
+    static constexpr size_t COUNT = std::size(entries);
+    static_assert(COUNT > 0, "enum_table needs at least one entry");
+
+    struct Params {
+        uint64_t multiplier = 0;
+        unsigned bits = 1;
+    };
+
+    static consteval Params search() {
+        // Equal keys defeat every multiplier; fail fast instead of searching
+        std::vector<uint64_t> keys;
+        for (const auto& [name, value] : entries)
+            keys.push_back(EnumWords(name.data(), name.size()).key(name.size()));
+        std::sort(keys.begin(), keys.end());
+        if (std::adjacent_find(keys.begin(), keys.end()) != keys.end())
+            return {};
+        const unsigned min_bits = std::max<unsigned>(1, std::bit_width(COUNT - 1));
+        for (unsigned bits = min_bits; bits <= min_bits + 6; ++bits) {
+            uint64_t state = 0;
+            for (int attempt = 0; attempt < 512; ++attempt) {
+                // splitmix64 sequence of odd multipliers
+                state += 0x9E3779B97F4A7C15ull;
+                uint64_t m = (state ^ (state >> 30)) * 0xBF58476D1CE4E5B9ull;
+                m = ((m ^ (m >> 27)) * 0x94D049BB133111EBull) ^ (m >> 31);
+                m |= 1;
+                std::vector<bool> used(size_t{1} << bits);
+                bool perfect = true;
+                for (const uint64_t key : keys) {
+                    const size_t slot = (key * m) >> (64 - bits);
+                    if (used[slot]) {
+                        perfect = false;
+                        break;
+                    }
+                    used[slot] = true;
+                }
+                if (perfect)
+                    return {m, bits};
+            }
+        }
+        return {};
+    }
+
+    static constexpr Params PARAMS = search();
+    static_assert(PARAMS.multiplier != 0,
+                  "no perfect hash found: enum_table names must be distinct");
+
+    static constexpr size_t slot_of(uint64_t key) noexcept {
+        return (key * PARAMS.multiplier) >> (64 - PARAMS.bits);
+    }
+
+    struct Slot {
+        EnumWords words{nullptr, 0};
+        const char* name = nullptr;
+        size_t size = SIZE_MAX;  // Empty slots match no input
+        E value{};
+    };
+
+    static consteval auto build() {
+        std::array<Slot, size_t{1} << PARAMS.bits> slots{};
+        for (const auto& [name, value] : entries) {
+            const EnumWords words(name.data(), name.size());
+            slots[slot_of(words.key(name.size()))] = {words, name.data(), name.size(), value};
         }
+        return slots;
+    }
+
+    static constexpr auto SLOTS = build();
+
+public:
+    [[nodiscard]] static std::optional<E> find(std::string_view s) noexcept {
+        const EnumWords words(s.data(), s.size());
+        const Slot& slot = SLOTS[slot_of(words.key(s.size()))];
+        // Words and length are exact up to 16 bytes; only longer names need the middle compared
+        if (slot.words.head != words.head || slot.words.tail != words.tail ||
+            slot.size != s.size() ||
+            (s.size() > 16 && std::memcmp(slot.name + 8, s.data() + 8, s.size() - 16) != 0))
+            return std::nullopt;
+        return slot.value;
+    }
+};
+
+}  // namespace detail
+
+// =============================================================================
+// LIGHTWEIGHT FIELD REFERENCE (16 bytes only)
+// =============================================================================
+
+class FieldRef {
+    const char* begin_;
+    const char* end_;
+
+public:
+    constexpr FieldRef() noexcept : begin_(nullptr), end_(nullptr) {}
+    constexpr FieldRef(const char* begin, const char* end) noexcept : begin_(begin), end_(end) {}
+
+    // --- Basic accessors (always inline) ---
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return {begin_, static_cast<size_t>(end_ - begin_)};
+    }
+    [[nodiscard]] constexpr const char* begin() const noexcept { return begin_; }
+    [[nodiscard]] constexpr const char* end() const noexcept { return end_; }
+    [[nodiscard]] constexpr size_t size() const noexcept { return end_ - begin_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return begin_ == end_; }
+
+    // --- Null check with policy ---
+    template <typename NullPol = NullStandard>
+    [[nodiscard]] constexpr bool is_null() const noexcept {
+        return NullPol::check(begin_, end_);
+    }
+
+    // ==========================================================================
+    // TYPE PARSING - Returns std::expected (C++23, zero-overhead error handling)
+    // ==========================================================================
+
+    // --- Integer parsing (fastest path) ---
+    template <typename T>
+        requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
+    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
+        T value{};
+        auto [ptr, ec] = std::from_chars(begin_, end_, value);
+        if (ec == std::errc{} && ptr == end_) {
+            return value;
+        }
+        return std::unexpected(ec == std::errc::result_out_of_range ? ErrorCode::OutOfRange
+                                                                    : ErrorCode::InvalidInteger);
+    }
+
+    // --- Floating point parsing ---
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
+        T value{};
+        if (parse_double_fast(value)) {
+            return value;
+        }
+        // Fallback to strtod
+        char* endptr = nullptr;
+        if constexpr (std::is_same_v<T, float>) {
+            value = std::strtof(begin_, &endptr);
+        } else {
+            value = std::strtod(begin_, &endptr);
+        }
+        if (endptr == end_) {
+            return value;
+        }
+        return std::unexpected(ErrorCode::InvalidFloat);
+    }
+
+    // --- Boolean parsing ---
+    template <typename T>
+        requires std::is_same_v<T, bool>
+    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
+        const size_t len = size();
+        if (len == 0)
+            return std::unexpected(ErrorCode::InvalidBool);
+
+        // Single character: 1/0, t/f, y/n
+        if (len == 1) {
+            char c = *begin_;
+            if (c == '1' || c == 't' || c == 'T' || c == 'y' || c == 'Y')
+                return true;
+            if (c == '0' || c == 'f' || c == 'F' || c == 'n' || c == 'N')
+                return false;
+        }
+
+        // Full words
+        if (len == 4) {
+            if (std::memcmp(begin_, "true", 4) == 0 || std::memcmp(begin_, "True", 4) == 0 ||
+                std::memcmp(begin_, "TRUE", 4) == 0)
+                return true;
+        }
+        if (len == 5) {
+            if (std::memcmp(begin_, "false", 5) == 0 || std::memcmp(begin_, "False", 5) == 0 ||
+                std::memcmp(begin_, "FALSE", 5) == 0)
+                return false;
+        }
+        if (len == 3) {
+            if (std::memcmp(begin_, "yes", 3) == 0 || std::memcmp(begin_, "Yes", 3) == 0 ||
+                std::memcmp(begin_, "YES", 3) == 0)
+                return true;
+        }
+        if (len == 2) {
+            if (std::memcmp(begin_, "no", 2) == 0 || std::memcmp(begin_, "No", 2) == 0 ||
+                std::memcmp(begin_, "NO", 2) == 0)
+                return false;
+        }
+
+        return std::unexpected(ErrorCode::InvalidBool);
+    }
+
+    // --- String (always succeeds) ---
+    template <typename T>
+        requires std::is_same_v<T, std::string_view>
+    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
+        return view();
+    }
+
+    template <typename T>
+        requires std::is_same_v<T, std::string>
+    [[nodiscard]] std::expected<T, ErrorCode> parse() const noexcept {
+        return std::string(begin_, end_);
+    }
+
+    // --- Allocator-aware string (e.g. backed by a per-thread arena) ---
+    template <typename T>
+        requires std::is_same_v<T, std::pmr::string>
+    [[nodiscard]] std::expected<T, ErrorCode> parse(
+        std::pmr::memory_resource* resource) const noexcept {
+        return std::pmr::string(begin_, end_, resource);
+    }
+
+    /// Copy the bytes into `arena`; the view stays valid for the arena's lifetime
+    [[nodiscard]] std::string_view intern_copy(std::pmr::memory_resource& arena) const noexcept {
+        if (begin_ == end_)
+            return {};
+        auto* copy = static_cast<char*>(arena.allocate(size(), 1));
+        std::memcpy(copy, begin_, size());
+        return {copy, size()};
+    }
+
+    // --- Enum parsing via enum_table<E> (exact, case-sensitive match) ---
+    template <MappedEnum E>
+    [[nodiscard]] std::expected<E, ErrorCode> parse_enum() const noexcept {
+        if (auto value = detail::EnumHash<E>::find(view()))
+            return *value;
+        return std::unexpected(ErrorCode::InvalidEnum);
+    }
+
+    // --- Date parsing (YYYY-MM-DD) ---
+    [[nodiscard]] std::expected<std::chrono::year_month_day, ErrorCode> parse_date()
+        const noexcept {
+        if (size() < 10)
+            return std::unexpected(ErrorCode::InvalidDate);
+
+        int year, month, day;
+        auto [p1, e1] = std::from_chars(begin_, begin_ + 4, year);
+        if (e1 != std::errc{} || *(begin_ + 4) != '-')
+            return std::unexpected(ErrorCode::InvalidDate);
+
+        auto [p2, e2] = std::from_chars(begin_ + 5, begin_ + 7, month);
+        if (e2 != std::errc{} || *(begin_ + 7) != '-')
+            return std::unexpected(ErrorCode::InvalidDate);
+
+        auto [p3, e3] = std::from_chars(begin_ + 8, begin_ + 10, day);
+        if (e3 != std::errc{})
+            return std::unexpected(ErrorCode::InvalidDate);
+
+        auto ymd = std::chrono::year{year} / std::chrono::month{static_cast<unsigned>(month)} /
+                   std::chrono::day{static_cast<unsigned>(day)};
+
+        if (!ymd.ok())
+            return std::unexpected(ErrorCode::InvalidDate);
+        return ymd;
+    }
+
+    // --- DateTime parsing (YYYY-MM-DD HH:MM:SS or YYYY-MM-DDTHH:MM:SS) ---
+    [[nodiscard]] std::expected<std::chrono::system_clock::time_point, ErrorCode> parse_datetime()
+        const noexcept {
+        if (size() < 19)
+            return std::unexpected(ErrorCode::InvalidDateTime);
+
+        auto date_result = parse_date();
+        if (!date_result)
+            return std::unexpected(date_result.error());
+
+        char sep = *(begin_ + 10);
+        if (sep != ' ' && sep != 'T')
+            return std::unexpected(ErrorCode::InvalidDateTime);
+
+        int hour, minute, second;
+        auto [p1, e1] = std::from_chars(begin_ + 11, begin_ + 13, hour);
+        if (e1 != std::errc{} || *(begin_ + 13) != ':')
+            return std::unexpected(ErrorCode::InvalidDateTime);
+
+        auto [p2, e2] = std::from_chars(begin_ + 14, begin_ + 16, minute);
+        if (e2 != std::errc{} || *(begin_ + 16) != ':')
+            return std::unexpected(ErrorCode::InvalidDateTime);
+
+        auto [p3, e3] = std::from_chars(begin_ + 17, begin_ + 19, second);
+        if (e3 != std::errc{})
+            return std::unexpected(ErrorCode::InvalidDateTime);
+
+        if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60)
+            return std::unexpected(ErrorCode::InvalidDateTime);
+
+        auto tp = std::chrono::sys_days{*date_result} + std::chrono::hours{hour} +
+                  std::chrono::minutes{minute} + std::chrono::seconds{second};
+
+        return std::chrono::time_point_cast<std::chrono::system_clock::duration>(tp);
+    }
+
+    // ==========================================================================
+    // CONVENIENCE METHODS
+    // ==========================================================================
+
+    /// Parse with default value on failure
+    template <typename T>
+    [[nodiscard]] T value_or(T default_value) const noexcept {
+        auto result = parse<T>();
+        return result ? *result : default_value;
+    }
+
+    /// Parse as optional (null-aware)
+    template <typename T, typename NullPol = NullStandard>
+    [[nodiscard]] std::optional<T> as_optional() const noexcept {
+        if (is_null<NullPol>())
+            return std::nullopt;
+        auto result = parse<T>();
+        return result ? std::optional<T>{*result} : std::nullopt;
+    }
+
+    /// Direct access for v1-compatible fast parsing
+    template <typename T>
+    [[nodiscard]] T as() const {
+        auto result = parse<T>();
+        return result.value_or(T{});
+    }
+
+private:
+    template <typename T>
+    bool parse_double_fast(T& x) const noexcept {
+        static_assert(std::is_floating_point_v<T>);
+        const char* p = begin_;
+        if (p >= end_)
+            return false;
+
+        bool negative = false;
+        if (*p == '-') {
+            negative = true;
+            ++p;
+        } else if (*p == '+') {
+            ++p;
+        }
+
+        if (p >= end_)
+            return false;
+
+        uint64_t int_part = 0;
+        while (p < end_ && *p >= '0' && *p <= '9') {
+            int_part = int_part * 10 + (*p - '0');
+            ++p;
+        }
+
+        x = static_cast<T>(int_part);
+
+        if (p < end_ && *p == '.') {
+            ++p;
+            T frac = 0.0;
+            T scale = static_cast<T>(0.1);
+            while (p < end_ && *p >= '0' && *p <= '9') {
+                frac += (*p - '0') * scale;
+                scale *= static_cast<T>(0.1);
+                ++p;
+            }
+            x += frac;
+        }
+
+        if (negative)
+            x = -x;
+        return p == end_;
+    }
+};
+
+// =============================================================================
+// SINGLE RECORD PARSING - Latency path for one line at a time
+// =============================================================================
+
+/// Tokenize one record (e.g. a UDP payload) into exactly Columns fields.
+///
+/// Stateless and allocation-free, with no prefetching. A trailing "\n" or
+/// "\r\n" is ignored. Delimiters are located 16 bytes per compare and popped
+/// from the bit mask; the field array is then filled by an unrolled loop.
+/// Returns ColumnCountMismatch unless the record has exactly Columns fields.
+template <size_t Columns, char Delim = ','>
+[[nodiscard]] BLAZECSV_HOT inline std::expected<std::array<FieldRef, Columns>, ErrorCode>
+parse_record(std::string_view record) noexcept {
+    static_assert(Columns > 0);
+    const char* const begin = record.data();
+    const char* end = begin + record.size();
+    if (end > begin && end[-1] == '\n')
+        --end;
+    if (end > begin && end[-1] == '\r')
+        --end;
+
+    if constexpr (Columns == 1) {
+        // The whole record is the field; any delimiter is one field too many
+        if (end > begin && std::memchr(begin, Delim, static_cast<size_t>(end - begin)))
+            return std::unexpected(ErrorCode::ColumnCountMismatch);
+        return std::array<FieldRef, 1>{FieldRef(begin, end)};
+    } else {
+        // Each separating delimiter ends one field and starts the next; one too many is an error
+        std::array<const char*, Columns> starts;
+        std::array<const char*, Columns> ends;
+        starts[0] = begin;
+        size_t found = 0;
+        auto separator = [&](const char* d) noexcept {
+            if (found == Columns - 1)
+                return false;
+            ends[found++] = d;
+            starts[found] = d + 1;
+            return true;
+        };
+
+        const char* p = begin;
+#if BLAZECSV_SIMD_NEON || BLAZECSV_SIMD_SSE2
+        for (; p + 16 <= end; p += 16) {
+            // Only the delimiter bitmap is used; the stop compare folds away
+            for (uint64_t mask = detail::block_masks(p, Delim).delims; mask != 0;
+                 mask &= mask - 1) {
+                if (!separator(p + (std::countr_zero(mask) >> detail::BLOCK_BIT_SHIFT)))
+                    return std::unexpected(ErrorCode::ColumnCountMismatch);
+            }
+        }
+#endif
+        for (; p < end; ++p) {
+            if (*p == Delim && !separator(p))
+                return std::unexpected(ErrorCode::ColumnCountMismatch);
+        }
+        if (found != Columns - 1)
+            return std::unexpected(ErrorCode::ColumnCountMismatch);
+        ends[Columns - 1] = end;
+
+        std::array<FieldRef, Columns> fields;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((fields[I] = FieldRef(starts[I], ends[I])), ...);
+        }(std::make_index_sequence<Columns>{});
+        return fields;
+    }
+}
+
+// =============================================================================
+// LAST-VALUE MEMOIZATION - Skip re-converting repeated column values
+// =============================================================================
+
+/// Caches the converted value of the previous row for one column.
+/// Sorted data repeats values in long runs (dates, symbols); when a field's
+/// bytes equal the previous row's (length check + memcmp), the cached result
+/// is returned without converting again. Fields longer than MAX_KEY bytes are
+/// always converted. Keep one memo per column per thread.
+template <typename T>
+class FieldMemo {
+public:
+    static constexpr size_t MAX_KEY = 32;
+    using result_type = std::expected<T, ErrorCode>;
+
+    /// Convert with FieldRef::parse<T>(), or parse_date() / parse_datetime() for
+    /// std::chrono::year_month_day / system_clock::time_point
+    const result_type& parse(const FieldRef& field) {
+        return get(field, [](const FieldRef& f) -> result_type {
+            if constexpr (std::is_same_v<T, std::chrono::year_month_day>) {
+                return f.parse_date();
+            } else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
+                return f.parse_datetime();
+            } else {
+                return f.template parse<T>();
+            }
+        });
+    }
+
+    /// Convert with a custom function
+    /// Convert: std::expected<T, ErrorCode>(const FieldRef&)
+    template <typename Convert>
+    const result_type& get(const FieldRef& field, Convert&& convert) {
+        const size_t len = field.size();
+        if (len == len_ && len <= MAX_KEY && std::memcmp(key_.data(), field.begin(), len) == 0) {
+            ++hits_;
+            return value_;
+        }
+
+        value_ = convert(field);
+        if (len <= MAX_KEY) {
+            std::memcpy(key_.data(), field.begin(), len);
+            len_ = len;
+        } else {
+            len_ = NO_KEY;  // Too long to remember
+        }
+        return value_;
+    }
+
+    /// Number of conversions skipped so far
+    [[nodiscard]] size_t hits() const noexcept { return hits_; }
+
+    void reset() noexcept {
+        len_ = NO_KEY;
+        hits_ = 0;
+    }
+
+private:
+    static constexpr size_t NO_KEY = std::numeric_limits<size_t>::max();
+
+    std::array<char, MAX_KEY> key_{};
+    size_t len_ = NO_KEY;
+    size_t hits_ = 0;
+    result_type value_{};
+};
+
+// =============================================================================
+// CSV READER - SIMD-ACCELERATED (Main Interface)
+// =============================================================================
+
+template <size_t Columns, char Delim = ',', typename ErrorPolicy = NoErrorCheck,
+          typename NullPol = NullStandard>
+class alignas(64) Reader {  // Cache-line aligned
+    FileSource source_;
+    const char* current_;
+    const char* end_;
+    const char* limit_;  // Rows must start before this; they may run on to end_
+
+    // Header storage - string_views into mmap (zero-copy)
+    std::array<std::string_view, Columns> column_names_;
+    bool header_parsed_ = false;
+
+    // Prefetch distances
+    static constexpr size_t PREFETCH_L1 = 64;    // One cache line
+    static constexpr size_t PREFETCH_L2 = 4096;  // One page
+
+    // Empty placeholder for disabled features (MSVC-compatible)
+    struct Empty {};
+
+    // Error tracking (only if enabled - zero bytes otherwise via [[no_unique_address]])
+    [[no_unique_address]] std::conditional_t<ErrorPolicy::enabled, ErrorInfo, Empty> last_error_{};
+    [[no_unique_address]] std::conditional_t<ErrorPolicy::track_line, uint32_t, Empty>
+        line_number_{};
+
+public:
+    explicit Reader(const std::string& filepath, bool skip_header = true)
+        : Reader(FileSource(filepath), skip_header) {}
+
+    /// Parse from an already-opened source (e.g. FileSource with a custom read threshold)
+    explicit Reader(FileSource source, bool skip_header = true)
+        : source_(std::move(source)),
+          current_(source_.data()),
+          end_(current_ + source_.size()),
+          limit_(end_) {
+        if constexpr (ErrorPolicy::enabled) {
+            if (!source_.opened())
+                last_error_ = ErrorInfo{ErrorCode::FileOpenError, 0, 0};
+        }
+        if (skip_header && source_.valid()) {
+            parse_header();
+        }
+    }
+
+    /// Byte-range reader: yields exactly the rows whose first byte lies in
+    /// [begin_offset, end_offset), as Hadoop's TextInputFormat does. Ranges
+    /// that tile the file therefore see every row once, with no coordination
+    /// between the processes reading them. A row that starts in the range is
+    /// read to its newline even past end_offset. The header always comes from
+    /// offset 0. Error line numbers count from the range's first row unless
+    /// begin_offset is 0.
+    Reader(const std::string& filepath, uint64_t begin_offset, uint64_t end_offset,
+           bool skip_header = true)
+        : Reader(FileSource(filepath), begin_offset, end_offset, skip_header) {}
+
+    Reader(FileSource source, uint64_t begin_offset, uint64_t end_offset, bool skip_header = true)
+        : Reader(std::move(source), skip_header) {
+        const char* const base = source_.data();
+        const uint64_t size = source_.size();
+        const uint64_t begin = std::min(begin_offset, size);
+        limit_ = base + std::max(begin, std::min(end_offset, size));
+
+        // The row under begin_offset belongs to the previous range unless
+        // begin_offset is exactly where it starts
+        const char* first = base + begin;
+        if (begin > 0 && first[-1] != '\n') {
+            first += detail::find_newline(first, end_ - first);
+            if (first < end_)
+                ++first;
+        }
+        if (first > current_) {
+            current_ = first;
+            if constexpr (ErrorPolicy::track_line)
+                line_number_ = 0;
+        }
+    }
+
+    // --- Header access ---
+    [[nodiscard]] std::string_view column_name(size_t idx) const noexcept {
+        return idx < Columns ? column_names_[idx] : std::string_view{};
+    }
+
+    [[nodiscard]] std::optional<size_t> column_index(std::string_view name) const noexcept {
+        for (size_t i = 0; i < Columns; ++i) {
+            if (column_names_[i] == name)
+                return i;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] const std::array<std::string_view, Columns>& headers() const noexcept {
+        return column_names_;
+    }
+
+    // --- Error access (only meaningful if ErrorPolicy::enabled) ---
+    [[nodiscard]] ErrorInfo last_error() const noexcept {
+        if constexpr (ErrorPolicy::enabled)
+            return last_error_;
+        return ErrorInfo{};
+    }
+
+    [[nodiscard]] bool has_error() const noexcept {
+        if constexpr (ErrorPolicy::enabled)
+            return !last_error_.ok();
+        return false;
+    }
+
+    // ==========================================================================
+    // SIMD-ACCELERATED ITERATION
+    // ==========================================================================
+
+    /// Maximum performance - raw pointers with SIMD
+    /// Callback: void(const char** starts, const char** ends)
+    template <typename Callback>
+    BLAZECSV_HOT size_t for_each_raw(Callback&& callback) {
+        size_t count = 0;
+        std::array<const char*, Columns> starts;
+        std::array<const char*, Columns> ends;
+        detail::RowLayout<Columns, Delim> layout;
+
+        while (current_ < limit_) {
+            // Dual-level prefetching
+            if (current_ + PREFETCH_L2 < end_) {
+                BLAZECSV_PREFETCH(current_ + PREFETCH_L1, 0, 3);  // L1, high temporal
+                BLAZECSV_PREFETCH(current_ + PREFETCH_L2, 0, 2);  // L2
+            }
+
+            if constexpr (ErrorPolicy::track_line) {
+                ++line_number_;
+            }
+
+            // Skip empty lines
+            if (*current_ == '\n') {
+                ++current_;
+                continue;
+            }
+            if (*current_ == '\r') {
+                ++current_;
+                if (current_ < end_ && *current_ == '\n')
+                    ++current_;
+                continue;
+            }
+
+            size_t col;
+            const char* line_end;
+
+            // Same delimiter layout as the previous line: fields are at the same offsets
+            if (!layout.match(current_, end_, starts.data(), ends.data(), col, line_end)) {
+                // Find line end using SIMD
+                size_t remaining = end_ - current_;
+                size_t line_len = detail::find_newline(current_, remaining);
+                line_end = current_ + line_len;
+
+                // Strip CR if present
+                const char* effective_end = line_end;
+                if (effective_end > current_ && *(effective_end - 1) == '\r') {
+                    --effective_end;
+                }
+
+                // Parse fields using SIMD
+                col = detail::split_fields<Columns, Delim>(current_, effective_end, starts.data(),
+                                                           ends.data());
+                layout.learn(current_, line_end, end_, starts.data(), ends.data(), col);
+            }
+
+            // Advance to next line
+            current_ = (line_end < end_) ? line_end + 1 : end_;
+
+            // Validate column count
+            if constexpr (ErrorPolicy::enabled) {
+                if (col != Columns) {
+                    last_error_ = ErrorInfo{ErrorCode::ColumnCountMismatch,
+                                            ErrorPolicy::track_line ? line_number_ : 0u,
+                                            static_cast<uint8_t>(col)};
+                    BLAZECSV_PROBE3(error, static_cast<int>(last_error_.code),
+                                    last_error_.line, col);
+                    continue;
+                }
+            }
+
+            callback(starts.data(), ends.data());
+            ++count;
+        }
+
+        return count;
+    }
+
+    /// FieldRef-based iteration with SIMD parsing
+    /// Callback: void(const std::array<FieldRef, Columns>&)
+    template <typename Callback>
+    BLAZECSV_HOT size_t for_each(Callback&& callback) {
+        return for_each_raw([&callback](const char** starts, const char** ends) {
+            std::array<FieldRef, Columns> fields;
+            // Unrolled for small column counts (compile-time)
+            for (size_t i = 0; i < Columns; ++i) {
+                fields[i] = FieldRef(starts[i], ends[i]);
+            }
+            callback(fields);
+        });
+    }
+
+    /// Process with early termination support
+    /// Callback: bool(const std::array<FieldRef, Columns>&) - return false to stop
+    template <typename Callback>
+    BLAZECSV_HOT size_t for_each_until(Callback&& callback) {
+        size_t count = 0;
+        std::array<const char*, Columns> starts;
+        std::array<const char*, Columns> ends;
+        detail::RowLayout<Columns, Delim> layout;
+
+        while (current_ < limit_) {
+            if (current_ + PREFETCH_L2 < end_) {
+                BLAZECSV_PREFETCH(current_ + PREFETCH_L1, 0, 3);
+                BLAZECSV_PREFETCH(current_ + PREFETCH_L2, 0, 2);
+            }
+
+            if constexpr (ErrorPolicy::track_line) {
+                ++line_number_;
+            }
+
+            if (*current_ == '\n') {
+                ++current_;
+                continue;
+            }
+            if (*current_ == '\r') {
+                ++current_;
+                if (current_ < end_ && *current_ == '\n')
+                    ++current_;
+                continue;
+            }
+
+            size_t col;
+            const char* line_end;
+            if (!layout.match(current_, end_, starts.data(), ends.data(), col, line_end)) {
+                size_t remaining = end_ - current_;
+                size_t line_len = detail::find_newline(current_, remaining);
+                line_end = current_ + line_len;
+                const char* effective_end = line_end;
+                if (effective_end > current_ && *(effective_end - 1) == '\r')
+                    --effective_end;
+
+                col = detail::split_fields<Columns, Delim>(current_, effective_end, starts.data(),
+                                                           ends.data());
+                layout.learn(current_, line_end, end_, starts.data(), ends.data(), col);
+            }
+
+            current_ = (line_end < end_) ? line_end + 1 : end_;
+
+            if constexpr (ErrorPolicy::enabled) {
+                if (col != Columns)
+                    continue;
+            }
+
+            std::array<FieldRef, Columns> fields;
+            for (size_t i = 0; i < Columns; ++i) {
+                fields[i] = FieldRef(starts[i], ends[i]);
+            }
+
+            ++count;
+            if (!callback(fields))
+                break;  // Early termination
+        }
+
+        return count;
+    }
+
+private:
+    void parse_header() {
+        if (current_ >= end_)
+            return;
+
+        if constexpr (ErrorPolicy::track_line) {
+            ++line_number_;
+        }
+
+        // Find header line end using SIMD
+        size_t line_len = detail::find_newline(current_, end_ - current_);
+        const char* line_end = current_ + line_len;
+        const char* effective_end = line_end;
+        if (effective_end > current_ && *(effective_end - 1) == '\r')
+            --effective_end;
+
+        // Parse header fields
+        const char* ptr = current_;
+        size_t col = 0;
+
+        while (col < Columns && ptr < effective_end) {
+            const char* start = ptr;
+            size_t field_len = detail::find_field_end(ptr, effective_end - ptr, Delim);
+            ptr += field_len;
+            column_names_[col] = std::string_view(start, ptr - start);
+            ++col;
+            if (ptr < effective_end && *ptr == Delim)
+                ++ptr;
+        }
+
+        BLAZECSV_PROBE2(header, col, static_cast<size_t>(line_end - current_));
+        current_ = (line_end < end_) ? line_end + 1 : end_;
+        header_parsed_ = true;
+    }
+};
+
+// =============================================================================
+// PARSE SCHEDULER - Shared worker pool with priorities and fair sharing
+// =============================================================================
+
+/// Scheduling class; a lower class only runs when no higher one has work
+enum class Priority : uint8_t { Interactive, Normal, Batch };
+
+/// Process-wide pool that parse jobs submit morsels to, instead of each job
+/// spawning its own threads.
+///
+/// A job is a count of morsels and a function run once per morsel index.
+/// Workers always take the next morsel from the highest non-empty priority
+/// class. Within a class, jobs share the workers in proportion to their
+/// weights (stride scheduling): the job with the smallest started/weight
+/// ratio goes next. Newcomers start level with the least-served job in their
+/// class, so a long batch job cannot delay a small one for long. Concurrency
+/// never exceeds the worker count.
+class ParseScheduler {
+public:
+    explicit ParseScheduler(size_t workers = std::thread::hardware_concurrency()) {
+        workers = std::max<size_t>(workers, 1);
+        threads_.reserve(workers);
+        for (size_t i = 0; i < workers; ++i)
+            threads_.emplace_back([this] { work(); });
+    }
+
+    ~ParseScheduler() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_all();
+        for (auto& t : threads_)
+            t.join();
+    }
+
+    ParseScheduler(const ParseScheduler&) = delete;
+    ParseScheduler& operator=(const ParseScheduler&) = delete;
+
+    /// Shared instance with one worker per hardware thread
+    [[nodiscard]] static ParseScheduler& global() {
+        static ParseScheduler scheduler;
+        return scheduler;
+    }
+
+    /// Run fn(i) for i in [0, morsels) on the pool; blocks until all finish.
+    /// Must not be called from inside a morsel.
+    template <typename MorselFn>
+    void run(size_t morsels, MorselFn&& fn, Priority priority = Priority::Normal,
+             uint32_t weight = 1) {
+        if (morsels == 0)
+            return;
+        Job job;
+        job.run = [&fn](size_t i) { fn(i); };
+        job.total = morsels;
+        job.priority = priority;
+        job.stride = 1.0 / std::max<uint32_t>(weight, 1);
+
+        std::unique_lock lock(mutex_);
+        job.pass = min_pass(priority);
+        jobs_.push_back(&job);
+        work_ready_.notify_all();
+        job_done_.wait(lock, [&] { return job.finished == job.total; });
+    }
+
+    [[nodiscard]] size_t worker_count() const noexcept { return threads_.size(); }
+
+    /// Jobs with morsels not yet started
+    [[nodiscard]] size_t queued_jobs() const {
+        std::lock_guard lock(mutex_);
+        return jobs_.size();
+    }
+
+private:
+    struct Job {
+        std::function<void(size_t)> run;
+        size_t total = 0;
+        size_t next = 0;      // Next morsel to start
+        size_t finished = 0;  // Morsels completed
+        Priority priority = Priority::Normal;
+        double stride = 1.0;  // 1 / weight
+        double pass = 0.0;    // Virtual time: morsels started * stride
+    };
+
+    std::vector<std::thread> threads_;
+    mutable std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable job_done_;
+    std::vector<Job*> jobs_;  // Jobs with morsels left to start
+    bool stopping_ = false;
+
+    [[nodiscard]] double min_pass(Priority priority) const noexcept {
+        double pass = std::numeric_limits<double>::max();
+        for (const Job* j : jobs_) {
+            if (j->priority == priority)
+                pass = std::min(pass, j->pass);
+        }
+        return pass == std::numeric_limits<double>::max() ? 0.0 : pass;
+    }
+
+    /// Highest class first, then the least-served job by weight
+    [[nodiscard]] size_t pick() const noexcept {
+        size_t best = 0;
+        for (size_t i = 1; i < jobs_.size(); ++i) {
+            const Job* j = jobs_[i];
+            const Job* b = jobs_[best];
+            if (j->priority < b->priority || (j->priority == b->priority && j->pass < b->pass))
+                best = i;
+        }
+        return best;
+    }
+
+    void work() {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            work_ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty())
+                return;  // Stopping
+
+            const size_t slot = pick();
+            Job* job = jobs_[slot];
+            const size_t morsel = job->next++;
+            job->pass += job->stride;
+            if (job->next == job->total)
+                jobs_.erase(jobs_.begin() + static_cast<std::ptrdiff_t>(slot));
+
+            lock.unlock();
+            job->run(morsel);
+            lock.lock();
+
+            if (++job->finished == job->total)
+                job_done_.notify_all();
+        }
+    }
+};
+
+// =============================================================================
+// PARALLEL READER - Multi-threaded SIMD processing
+// =============================================================================
+
+namespace detail {
+
+/// Cut [data, data + size) into ranges of about `bytes`, each ending just
+/// past a newline. Returns the boundaries: range i is [bounds[i], bounds[i+1]).
+inline std::vector<const char*> morsel_bounds(const char* data, size_t size, size_t bytes) {
+    const char* const end = data + size;
+    std::vector<const char*> bounds{data};
+    while (bounds.back() < end) {
+        const char* p = bounds.back();
+        p += std::min<size_t>(bytes, end - p);
+        if (p < end) {
+            p += find_newline(p, end - p);
+            if (p < end)
+                ++p;
+        }
+        bounds.push_back(p);
+    }
+    return bounds;
+}
+
+}  // namespace detail
+
+template <size_t Columns, char Delim = ',', typename NullPol = NullStandard>
+class ParallelReader {
+    FileSource source_;
+    const char* data_;
+    size_t size_;
+    size_t num_threads_;
+
+    std::array<std::string_view, Columns> column_names_;
+
+    // Per-worker arenas handed out by for_each_parallel_with_arena()
+    static constexpr size_t ARENA_INITIAL_SIZE = 64 * 1024;
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> arenas_;
+
+    // Shared pool to run chunks on instead of per-call threads
+    ParseScheduler* scheduler_ = nullptr;
+    Priority priority_ = Priority::Normal;
+    uint32_t weight_ = 1;
+
+public:
+    explicit ParallelReader(const std::string& filepath, size_t num_threads = 4,
+                            bool skip_header = true)
+        : ParallelReader(FileSource(filepath), num_threads, skip_header) {}
+
+    explicit ParallelReader(FileSource source, size_t num_threads = 4, bool skip_header = true)
+        : source_(std::move(source)),
+          data_(source_.data()),
+          size_(source_.size()),
+          num_threads_(num_threads) {
+        if (skip_header && source_.valid()) {
+            // Skip header and capture names
+            size_t nl = detail::find_newline(data_, size_);
+            const char* line_end = data_ + nl;
+            const char* ptr = data_;
+            size_t col = 0;
+            while (col < Columns && ptr < line_end) {
+                const char* start = ptr;
+                size_t field_len = detail::find_field_end(ptr, line_end - ptr, Delim);
+                ptr += field_len;
+                column_names_[col++] = std::string_view(start, ptr - start);
+                if (ptr < line_end && *ptr == Delim)
+                    ++ptr;
+            }
+            BLAZECSV_PROBE2(header, col, nl);
+            data_ = (line_end < data_ + size_) ? line_end + 1 : data_ + size_;
+            size_ = (source_.data() + source_.size()) - data_;
+        }
+    }
+
+    [[nodiscard]] const std::array<std::string_view, Columns>& headers() const noexcept {
+        return column_names_;
+    }
+
+    /// Parallel iteration with SIMD
+    /// Note: Callback may be invoked from multiple threads!
+    template <typename Callback>
+    size_t for_each_parallel(Callback&& callback) {
+        return run_parallel([&](size_t, const char* begin, const char* end) {
+            return parse_chunk(begin, end, callback);
+        });
+    }
+
+    /// Parallel iteration with a per-worker monotonic arena for string materialization
+    /// Callback: void(const std::array<FieldRef, Columns>&, std::pmr::memory_resource& arena)
+    /// Arenas are owned by the reader: views from intern_copy() remain valid until
+    /// release_arenas() or destruction. Each arena is only ever used by one thread.
+    template <typename Callback>
+    size_t for_each_parallel_with_arena(Callback&& callback) {
+        std::vector<std::pmr::memory_resource*> slots;
+        for (size_t i = 0; i < num_threads_; ++i) {
+            arenas_.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(
+                ARENA_INITIAL_SIZE, std::pmr::new_delete_resource()));
+            slots.push_back(arenas_.back().get());
+        }
+        return run_parallel([&](size_t chunk, const char* begin, const char* end) {
+            std::pmr::memory_resource& arena = *slots[chunk];
+            auto with_arena = [&](const std::array<FieldRef, Columns>& fields) {
+                callback(fields, arena);
+            };
+            return parse_chunk(begin, end, with_arena);
+        });
+    }
+
+    /// Free all memory handed out by for_each_parallel_with_arena()
+    void release_arenas() noexcept { arenas_.clear(); }
+
+    /// Parallel iteration over newline-aligned chunks; chunk indices follow file order
+    /// and are below num_threads(). Tokenize a chunk with scan_lines().
+    /// Callback: void(size_t chunk_index, const char* begin, const char* end), or
+    /// size_t(...) returning the chunk's row count for the chunk_end probe
+    /// Returns the number of chunks
+    template <typename Callback>
+    size_t for_each_chunk(Callback&& callback) {
+        std::atomic<size_t> chunks{0};
+        run_parallel([&](size_t chunk, const char* begin, const char* end) -> size_t {
+            chunks.fetch_add(1, std::memory_order_relaxed);
+            if constexpr (std::is_void_v<std::invoke_result_t<Callback&, size_t, const char*,
+                                                              const char*>>) {
+                callback(chunk, begin, end);
+                return 0;
+            } else {
+                return callback(chunk, begin, end);
+            }
+        });
+        return chunks.load();
+    }
+
+    /// Bytes per morsel in for_each_by_key()
+    static constexpr size_t KEYED_MORSEL_BYTES = 1 << 20;
+
+    /// Key-affine iteration: rows are tokenized in parallel, then each row is
+    /// delivered on the consumer thread its `key_column` hashes to, in file
+    /// order. All rows of a key reach the same thread in sequence, so per-key
+    /// state in the callback needs no locks.
+    /// Callback: void(size_t consumer, const std::array<FieldRef, Columns>&)
+    /// Returns the number of rows delivered
+    ///
+    /// The body is cut into KEYED_MORSEL_BYTES morsels that num_threads()
+    /// parse threads claim in order. A parsed morsel holds one row list per
+    /// consumer in a ring of 2 * num_threads() slots; consumer c visits the
+    /// morsels in sequence and takes only its own list, so every (slot,
+    /// consumer) pair is single-producer single-consumer. A slot is refilled
+    /// once all consumers have released it, which bounds memory to the ring.
+    ///
+    /// With use_scheduler(), the morsels are parsed on the scheduler's
+    /// workers at the reader's priority and weight; consumers stay on their
+    /// own threads. A worker whose slot is still held by slow consumers waits
+    /// for it, so consumers throttle the pool share the job can take.
+    template <typename Callback>
+    size_t for_each_by_key(size_t key_column, size_t consumers, Callback&& callback) {
+        using Row = std::array<FieldRef, Columns>;
+        if (size_ == 0 || consumers == 0 || key_column >= Columns)
+            return 0;
+
+        const std::vector<const char*> bounds =
+            detail::morsel_bounds(data_, size_, KEYED_MORSEL_BYTES);
+        const size_t morsels = bounds.size() - 1;
+        const size_t parsers = std::clamp<size_t>(
+            scheduler_ != nullptr ? scheduler_->worker_count() : num_threads_, 1, morsels);
+
+        struct Slot {
+            std::vector<std::vector<Row>> rows;  // Per consumer
+            size_t expected = 0;                 // Next morsel allowed to fill the slot
+            size_t published = SIZE_MAX;         // Morsel the rows belong to
+            size_t pending = 0;                  // Consumers yet to release it
+        };
+        std::vector<Slot> slots(2 * parsers);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            slots[i].rows.resize(consumers);
+            slots[i].expected = i;
+        }
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::condition_variable freed;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> total{0};
+
+        // Morsels start in index order on both paths, so the lowest running one
+        // always finds its slot released once consumers catch up
+        auto parse_morsel = [&](size_t m) {
+            Slot& slot = slots[m % slots.size()];
+            {
+                std::unique_lock lock(mutex);
+                freed.wait(lock, [&] { return slot.expected == m; });
+            }
+            for (auto& list : slot.rows)
+                list.clear();
+            scan_lines(bounds[m], bounds[m + 1],
+                       [&](const char** starts, const char** ends, size_t col) {
+                           if (col != Columns)
+                               return;
+                           const std::string_view key(starts[key_column],
+                                                      ends[key_column] - starts[key_column]);
+                           const size_t c = std::hash<std::string_view>{}(key) % consumers;
+                           Row& row = slot.rows[c].emplace_back();
+                           for (size_t i = 0; i < Columns; ++i)
+                               row[i] = FieldRef(starts[i], ends[i]);
+                       });
+            {
+                std::lock_guard lock(mutex);
+                slot.published = m;
+                slot.pending = consumers;
+            }
+            ready.notify_all();
+        };
+        auto parse = [&] {
+            for (size_t m; (m = next.fetch_add(1, std::memory_order_relaxed)) < morsels;)
+                parse_morsel(m);
+        };
+
+        auto consume = [&](size_t c) {
+            size_t count = 0;
+            for (size_t m = 0; m < morsels; ++m) {
+                Slot& slot = slots[m % slots.size()];
+                {
+                    std::unique_lock lock(mutex);
+                    ready.wait(lock, [&] { return slot.published == m; });
+                }
+                for (const Row& row : slot.rows[c])
+                    callback(c, row);
+                count += slot.rows[c].size();
+                std::lock_guard lock(mutex);
+                if (--slot.pending == 0) {
+                    slot.expected = m + slots.size();
+                    freed.notify_all();
+                }
+            }
+            total.fetch_add(count, std::memory_order_relaxed);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(parsers + consumers);
+        for (size_t c = 0; c < consumers; ++c)
+            threads.emplace_back(consume, c);
+        if (scheduler_ != nullptr) {
+            scheduler_->run(morsels, parse_morsel, priority_, weight_);
+        } else {
+            for (size_t i = 0; i < parsers; ++i)
+                threads.emplace_back(parse);
+        }
+        for (auto& thread : threads)
+            thread.join();
+        return total.load();
+    }
+
+    [[nodiscard]] size_t num_threads() const noexcept { return num_threads_; }
+
+    /// Run chunks as morsels on a shared scheduler instead of spawning
+    /// num_threads threads per call. num_threads then only sets the chunk
+    /// count; the scheduler caps concurrency.
+    void use_scheduler(ParseScheduler& scheduler, Priority priority = Priority::Normal,
+                       uint32_t weight = 1) noexcept {
+        scheduler_ = &scheduler;
+        priority_ = priority;
+        weight_ = weight;
+    }
+
+    /// Tokenize a newline-aligned range on the calling thread, reporting every
+    /// non-empty line, including lines whose field count is not Columns
+    /// LineCallback: void(const char** starts, const char** ends, size_t fields_found)
+    template <typename LineCallback>
+    static void scan_lines(const char* start, const char* end, LineCallback&& on_line) {
+        const char* current = start;
+
+        std::array<const char*, Columns> starts;
+        std::array<const char*, Columns> ends;
+        detail::RowLayout<Columns, Delim> layout;
+
+        while (current < end) {
+            // Prefetch
+            if (current + 4096 < end) {
+                BLAZECSV_PREFETCH(current + 64, 0, 3);
+                BLAZECSV_PREFETCH(current + 4096, 0, 2);
+            }
+
+            if (*current == '\n') {
+                ++current;
+                continue;
+            }
+            if (*current == '\r') {
+                ++current;
+                if (current < end && *current == '\n')
+                    ++current;
+                continue;
+            }
+
+            size_t col;
+            const char* line_end;
+            if (!layout.match(current, end, starts.data(), ends.data(), col, line_end)) {
+                size_t line_len = detail::find_newline(current, end - current);
+                line_end = current + line_len;
+                const char* effective_end = line_end;
+                if (effective_end > current && *(effective_end - 1) == '\r')
+                    --effective_end;
+
+                col = detail::split_fields<Columns, Delim>(current, effective_end, starts.data(),
+                                                           ends.data());
+                layout.learn(current, line_end, end, starts.data(), ends.data(), col);
+            }
+
+            current = (line_end < end) ? line_end + 1 : end;
+
+            on_line(starts.data(), ends.data(), col);
+        }
+    }
+
+private:
+    /// Split the data at newlines into at most num_threads_ chunks and run
+    /// ChunkFn: size_t(size_t chunk_index, const char* begin, const char* end) on each
+    template <typename ChunkFn>
+    size_t run_parallel(ChunkFn&& chunk_fn) {
+        if (size_ == 0)
+            return 0;
+
+        // Find chunk boundaries (must be at newlines)
+        std::vector<std::pair<const char*, const char*>> chunks;
+        chunks.reserve(num_threads_);
+
+        size_t chunk_size = size_ / num_threads_;
+        const char* chunk_start = data_;
+
+        for (size_t i = 0; i < num_threads_ - 1 && chunk_start < data_ + size_; ++i) {
+            const char* approx_end = chunk_start + chunk_size;
+            if (approx_end >= data_ + size_) {
+                approx_end = data_ + size_;
+            } else {
+                // Find next newline
+                size_t remaining = (data_ + size_) - approx_end;
+                size_t nl = detail::find_newline(approx_end, remaining);
+                approx_end += nl;
+                if (approx_end < data_ + size_)
+                    ++approx_end;  // Skip the newline
+            }
+
+            chunks.emplace_back(chunk_start, approx_end);
+            chunk_start = approx_end;
+        }
+
+        // Last chunk
+        if (chunk_start < data_ + size_) {
+            chunks.emplace_back(chunk_start, data_ + size_);
+        }
+
+        // Process chunks in parallel
+        std::vector<std::atomic<size_t>> counts(chunks.size());
+        auto run_chunk = [&](size_t i) {
+            const auto [begin, end] = chunks[i];
+            BLAZECSV_PROBE2(chunk_start, begin, static_cast<size_t>(end - begin));
+            counts[i].store(chunk_fn(i, begin, end));
+            BLAZECSV_PROBE3(chunk_end, begin, static_cast<size_t>(end - begin), counts[i].load());
+        };
+        if (scheduler_ != nullptr) {
+            scheduler_->run(chunks.size(), run_chunk, priority_, weight_);
+            size_t total = 0;
+            for (auto& c : counts)
+                total += c.load();
+            return total;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(chunks.size());
+
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            threads.emplace_back([&, i]() { run_chunk(i); });
+        }
+
+        // Wait and sum
+        size_t total = 0;
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+            total += counts[i].load();
+        }
+
+        return total;
+    }
+
+    template <typename Callback>
+    static size_t parse_chunk(const char* start, const char* end, Callback& callback) {
+        size_t count = 0;
+        scan_lines(start, end, [&](const char** starts, const char** ends, size_t col) {
+            if (col == Columns) {
+                std::array<FieldRef, Columns> fields;
+                for (size_t i = 0; i < Columns; ++i) {
+                    fields[i] = FieldRef(starts[i], ends[i]);
+                }
+                callback(fields);
+                ++count;
+            }
+        });
+        return count;
+    }
+};
+
+// =============================================================================
+// STREAMING PARALLEL READER - Pipes and decompressor output across cores
+// =============================================================================
+
+/// Parallel parsing of a non-seekable input such as a pipe or the output of
+/// a decompressor. One reader thread fills large blocks and cuts each one at
+/// its last newline, carrying the partial line into the next block; worker
+/// threads tokenize the blocks. The serial stage does only the read, the
+/// carry memcpy and a backwards newline search.
+///
+/// Block buffers are recycled through a fixed ring of 2 * num_threads + 2,
+/// so memory stays bounded however fast the input arrives. A line longer
+/// than a block grows that block. The input is consumed by the first
+/// for_each_* call. Rows whose field count is not Columns are skipped, as in
+/// ParallelReader.
+///
+/// A failed read ends the input: complete lines read before it are still
+/// delivered, the unterminated tail is dropped, and error() then returns
+/// ErrorCode::ReadError.
+template <size_t Columns, char Delim = ',', typename NullPol = NullStandard>
+class StreamingParallelReader {
+public:
+    using Row = std::array<FieldRef, Columns>;
+
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4 << 20;
+
+    /// Read from a stdio stream (e.g. stdin or popen()); not closed here
+    explicit StreamingParallelReader(std::FILE* stream, size_t num_threads = 4,
+                                     bool skip_header = true,
+                                     size_t block_size = DEFAULT_BLOCK_SIZE)
+        : StreamingParallelReader(
+              [stream](char* out, size_t n) -> std::expected<size_t, ErrorCode> {
+                  const size_t got = std::fread(out, 1, n, stream);
+                  if (got == 0 && std::ferror(stream))
+                      return std::unexpected(ErrorCode::ReadError);
+                  return got;
+              },
+              num_threads, skip_header, block_size) {}
+
+#if !defined(_WIN32)
+    /// Read from a file descriptor (e.g. a pipe); not closed here
+    explicit StreamingParallelReader(int fd, size_t num_threads = 4, bool skip_header = true,
+                                     size_t block_size = DEFAULT_BLOCK_SIZE)
+        : StreamingParallelReader(
+              [fd](char* out, size_t n) -> std::expected<size_t, ErrorCode> {
+                  for (;;) {
+                      ssize_t got = ::read(fd, out, n);
+                      if (got >= 0)
+                          return static_cast<size_t>(got);
+                      if (errno != EINTR)
+                          return std::unexpected(ErrorCode::ReadError);
+                  }
+              },
+              num_threads, skip_header, block_size) {}
+#endif
+
+    /// Read from any source; ReadFn: size_t(char* out, size_t max), 0 at end of
+    /// input, or std::expected<size_t, ErrorCode>(char* out, size_t max) to
+    /// report failures
+    template <typename ReadFn>
+        requires std::is_invocable_r_v<std::expected<size_t, ErrorCode>, ReadFn&, char*, size_t>
+    StreamingParallelReader(ReadFn read, size_t num_threads, bool skip_header = true,
+                            size_t block_size = DEFAULT_BLOCK_SIZE)
+        : read_(std::move(read)),
+          num_threads_(std::max<size_t>(num_threads, 1)),
+          block_size_(std::max<size_t>(block_size, 4096)) {
+        // The first block is read now so the header is available before iterating
+        first_ = std::make_unique<Block>();
+        if (!fill(*first_)) {
+            first_.reset();
+            return;
+        }
+        if (skip_header) {
+            const char* data = first_->data.data();
+            const char* end = data + first_->size;
+            const char* line_end = data + detail::find_newline(data, end - data);
+            const char* effective_end = line_end;
+            if (effective_end > data && *(effective_end - 1) == '\r')
+                --effective_end;
+            const char* ptr = data;
+            for (size_t col = 0; col < Columns && ptr < effective_end; ++col) {
+                const char* start = ptr;
+                ptr += detail::find_field_end(ptr, effective_end - ptr, Delim);
+                names_[col].assign(start, ptr);
+                if (ptr < effective_end && *ptr == Delim)
+                    ++ptr;
+            }
+            first_->begin = (line_end < end ? line_end + 1 : end) - data;
+        }
+        for (size_t i = 0; i < Columns; ++i)
+            column_names_[i] = names_[i];
+    }
+
+    StreamingParallelReader(const StreamingParallelReader&) = delete;
+    StreamingParallelReader& operator=(const StreamingParallelReader&) = delete;
+
+    [[nodiscard]] const std::array<std::string_view, Columns>& headers() const noexcept {
+        return column_names_;
+    }
+
+    [[nodiscard]] size_t num_threads() const noexcept { return num_threads_; }
+
+    /// ErrorCode::ReadError if the input failed, Ok otherwise. Final once a
+    /// for_each_* call has returned.
+    [[nodiscard]] ErrorCode error() const noexcept { return error_; }
+
+    /// Callback may be invoked from multiple threads, in no particular order
+    /// Callback: void(const std::array<FieldRef, Columns>&)
+    /// Returns the number of rows
+    template <typename Callback>
+    size_t for_each_parallel(Callback&& callback) {
+        std::atomic<size_t> total{0};
+        run([&](Block& block) {
+            size_t count = 0;
+            scan(block, [&](const Row& row) {
+                callback(row);
+                ++count;
+            });
+            total.fetch_add(count, std::memory_order_relaxed);
+            return false;
+        }, [](Block&) {});
+        return total.load();
+    }
+
+    /// Rows in input order, one at a time on the calling thread; workers
+    /// still tokenize ahead in parallel
+    /// Callback: void(const std::array<FieldRef, Columns>&)
+    /// Returns the number of rows
+    template <typename Callback>
+    size_t for_each_ordered(Callback&& callback) {
+        size_t total = 0;
+        run([&](Block& block) {
+            block.rows.clear();
+            scan(block, [&](const Row& row) { block.rows.push_back(row); });
+            return true;
+        }, [&](Block& block) {
+            for (const Row& row : block.rows)
+                callback(row);
+            total += block.rows.size();
+        });
+        return total;
+    }
+
+private:
+    struct Block {
+        size_t index = 0;
+        std::vector<char> data;
+        size_t begin = 0;  // Data start (past the header in block 0)
+        size_t size = 0;   // Bytes up to and including the last newline
+        std::vector<Row> rows;
+    };
+    using BlockPtr = std::unique_ptr<Block>;
+
+    template <typename RowFn>
+    static void scan(const Block& block, RowFn&& on_row) {
+        const char* data = block.data.data();
+        ParallelReader<Columns, Delim, NullPol>::scan_lines(
+            data + block.begin, data + block.size,
+            [&](const char** starts, const char** ends, size_t col) {
+                if (col != Columns)
+                    return;
+                Row row;
+                for (size_t i = 0; i < Columns; ++i)
+                    row[i] = FieldRef(starts[i], ends[i]);
+                on_row(row);
+            });
+    }
+
+    /// Read the next block: carried bytes, then input up to the block size,
+    /// cut after the last newline. False once the input is exhausted. After a
+    /// read error the block keeps only complete lines.
+    bool fill(Block& block) {
+        if (eof_ && carry_.empty())
+            return false;
+        if (block.data.size() < std::max(block_size_, carry_.size()))
+            block.data.resize(std::max(block_size_, 2 * carry_.size()));
+        if (!carry_.empty())
+            std::memcpy(block.data.data(), carry_.data(), carry_.size());
+        size_t filled = carry_.size();
+        carry_.clear();
+        size_t searched = 0;  // Bytes known to contain no newline
+
+        for (;;) {
+            while (!eof_ && filled < block.data.size()) {
+                auto got = read_(block.data.data() + filled, block.data.size() - filled);
+                if (!got)
+                    error_ = got.error();
+                if (!got || *got == 0)
+                    eof_ = true;
+                else
+                    filled += *got;
+            }
+            const char* data = block.data.data();
+            if (eof_) {
+                // The line a failed read cut short is dropped, not parsed as a row
+                while (error_ != ErrorCode::Ok && filled > 0 && data[filled - 1] != '\n')
+                    --filled;
+                block.size = filled;
+                break;
+            }
+            const char* last = data + filled;
+            while (last > data + searched && last[-1] != '\n')
+                --last;
+            if (last > data + searched) {
+                block.size = last - data;
+                carry_.assign(last, data + filled);
+                break;
+            }
+            searched = filled;
+            block.data.resize(2 * block.data.size());  // One line longer than the block
+        }
+        block.begin = 0;
+        block.index = next_index_++;
+        return block.size > 0;
+    }
+
+    /// Reader thread -> workers (`work`) -> optional in-order `deliver` on
+    /// this thread. `work` returns true to hand the block on for delivery.
+    template <typename Work, typename Deliver>
+    void run(Work&& work, Deliver&& deliver) {
+        if (!first_)
+            return;
+        const size_t ring = 2 * num_threads_ + 2;
+        detail::BoundedQueue<BlockPtr> free_blocks(ring);
+        detail::BoundedQueue<BlockPtr> jobs(ring);
+        for (size_t i = 1; i < ring; ++i)
+            free_blocks.push(std::make_unique<Block>());
+
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        // Tokenized blocks awaiting in-order delivery. At most `ring` blocks exist
+        // and all below the next one to deliver are back on free_blocks, so
+        // index % ring is unique among them.
+        std::vector<BlockPtr> done(ring);
+        bool finished = false;
+        size_t workers_left = num_threads_;
+
+        std::thread reader([&] {
+            jobs.push(std::move(first_));
+            for (;;) {
+                std::optional<BlockPtr> block = free_blocks.pop();
+                if (!block || !fill(**block))
+                    break;
+                jobs.push(std::move(*block));
+            }
+            jobs.close();
+        });
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads_);
+        for (size_t t = 0; t < num_threads_; ++t) {
+            workers.emplace_back([&] {
+                while (std::optional<BlockPtr> block = jobs.pop()) {
+                    if (work(**block)) {
+                        std::lock_guard lock(mutex);
+                        const size_t index = (*block)->index;
+                        done[index % ring] = std::move(*block);
+                        done_cv.notify_all();
+                    } else {
+                        free_blocks.push(std::move(*block));
+                    }
+                }
+                std::lock_guard lock(mutex);
+                finished = --workers_left == 0;
+                done_cv.notify_all();
+            });
+        }
+
+        for (size_t next = 0;; ++next) {
+            BlockPtr block;
+            {
+                std::unique_lock lock(mutex);
+                BlockPtr& slot = done[next % ring];
+                done_cv.wait(lock, [&] { return slot || finished; });
+                if (!slot)
+                    break;
+                block = std::move(slot);
+            }
+            deliver(*block);
+            free_blocks.push(std::move(block));
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+        free_blocks.close();
+        reader.join();
+    }
+
+    std::function<std::expected<size_t, ErrorCode>(char*, size_t)> read_;
+    size_t num_threads_;
+    size_t block_size_;
+    bool eof_ = false;
+    ErrorCode error_ = ErrorCode::Ok;  // Written by the reader thread, read after join
+    size_t next_index_ = 0;
+    std::vector<char> carry_;
+    BlockPtr first_;
+    std::array<std::string, Columns> names_;
+    std::array<std::string_view, Columns> column_names_;
+};
+
+// =============================================================================
+// WIDE READER - Runtime column count for very wide files
+// =============================================================================
+
+/// A tokenized row of a WideReader.
+/// Fields are stored as compact 32-bit end offsets relative to the line start;
+/// field i starts one byte (the delimiter) after field i-1 ends.
+class WideRow {
+    const char* line_ = nullptr;
+    const uint32_t* ends_ = nullptr;
+    size_t count_ = 0;
+
+public:
+    constexpr WideRow() noexcept = default;
+    constexpr WideRow(const char* line, const uint32_t* ends, size_t count) noexcept
+        : line_(line), ends_(ends), count_(count) {}
+
+    /// Number of fields tokenized (may stop early when columns were selected)
+    [[nodiscard]] constexpr size_t size() const noexcept { return count_; }
+
+    /// Unchecked access
+    [[nodiscard]] constexpr FieldRef operator[](size_t i) const noexcept {
+        const uint32_t start = i ? ends_[i - 1] + 1 : 0;
+        return FieldRef(line_ + start, line_ + ends_[i]);
+    }
+
+    /// Checked access - empty field if the row has fewer columns
+    [[nodiscard]] constexpr FieldRef at(size_t i) const noexcept {
+        return i < count_ ? (*this)[i] : FieldRef{};
+    }
+};
+
+template <char Delim = ','>
+class WideReader {
+    FileSource source_;
+    const char* current_;
+    const char* end_;
+
+    std::vector<std::string_view> column_names_;
+    std::vector<uint32_t> ends_;  // Reused for every row
+
+    static constexpr size_t PREFETCH_L1 = 64;
+    static constexpr size_t PREFETCH_L2 = 4096;
+    static constexpr size_t ALL_COLUMNS = std::numeric_limits<size_t>::max();
+
+public:
+    explicit WideReader(const std::string& filepath, bool skip_header = true)
+        : WideReader(FileSource(filepath), skip_header) {}
+
+    explicit WideReader(FileSource source, bool skip_header = true)
+        : source_(std::move(source)), current_(source_.data()), end_(current_ + source_.size()) {
+        if (skip_header && source_.valid()) {
+            const char* line_end = next_line_end();
+            const char* effective_end = strip_cr(current_, line_end);
+            size_t n = tokenize(current_, effective_end, ALL_COLUMNS);
+            column_names_.reserve(n);
+            WideRow header(current_, ends_.data(), n);
+            for (size_t i = 0; i < n; ++i)
+                column_names_.push_back(header[i].view());
+            current_ = (line_end < end_) ? line_end + 1 : end_;
+        }
+    }
+
+    // --- Header access ---
+    [[nodiscard]] const std::vector<std::string_view>& headers() const noexcept {
+        return column_names_;
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept { return column_names_.size(); }
+
+    [[nodiscard]] std::optional<size_t> column_index(std::string_view name) const noexcept {
+        for (size_t i = 0; i < column_names_.size(); ++i) {
+            if (column_names_[i] == name)
+                return i;
+        }
+        return std::nullopt;
+    }
+
+    /// Iterate over full rows
+    /// Callback: void(const WideRow&)
+    template <typename Callback>
+    BLAZECSV_HOT size_t for_each(Callback&& callback) {
+        return scan(ALL_COLUMNS, [&](const WideRow& row) { callback(row); });
+    }
+
+    /// Iterate over a sparse set of columns; tokenizing stops at the highest one.
+    /// Callback: void(std::span<const FieldRef> fields) - fields in `columns` order,
+    /// empty for columns a row does not have
+    template <typename Callback>
+    BLAZECSV_HOT size_t for_each_selected(std::span<const size_t> columns, Callback&& callback) {
+        if (columns.empty())
+            return 0;
+        const size_t limit = *std::max_element(columns.begin(), columns.end()) + 1;
+        std::vector<FieldRef> selected(columns.size());
+        return scan(limit, [&](const WideRow& row) {
+            for (size_t i = 0; i < columns.size(); ++i)
+                selected[i] = row.at(columns[i]);
+            callback(std::span<const FieldRef>(selected));
+        });
+    }
+
+private:
+    template <typename RowFn>
+    size_t scan(size_t limit, RowFn&& row_fn) {
+        size_t count = 0;
+        while (current_ < end_) {
+            if (current_ + PREFETCH_L2 < end_) {
+                BLAZECSV_PREFETCH(current_ + PREFETCH_L1, 0, 3);
+                BLAZECSV_PREFETCH(current_ + PREFETCH_L2, 0, 2);
+            }
+
+            // Skip empty lines
+            if (*current_ == '\n') {
+                ++current_;
+                continue;
+            }
+            if (*current_ == '\r') {
+                ++current_;
+                if (current_ < end_ && *current_ == '\n')
+                    ++current_;
+                continue;
+            }
+
+            const char* line_end = next_line_end();
+            size_t n = tokenize(current_, strip_cr(current_, line_end), limit);
+            row_fn(WideRow(current_, ends_.data(), n));
+            ++count;
+
+            current_ = (line_end < end_) ? line_end + 1 : end_;
+        }
+        return count;
+    }
+
+    /// Fill ends_ with up to `limit` field end offsets; returns the field count
+    BLAZECSV_HOT size_t tokenize(const char* line, const char* effective_end, size_t limit) {
+        return detail::for_each_field<Delim>(
+            line, effective_end, limit, [&](size_t col, const char*, const char* end) {
+                if (col == ends_.size())
+                    ends_.resize(ends_.empty() ? 64 : ends_.size() * 2);
+                ends_[col] = static_cast<uint32_t>(end - line);
+            });
+    }
+
+    [[nodiscard]] const char* next_line_end() const noexcept {
+        return current_ + detail::find_newline(current_, end_ - current_);
+    }
+
+    [[nodiscard]] static const char* strip_cr(const char* line, const char* line_end) noexcept {
+        return (line_end > line && *(line_end - 1) == '\r') ? line_end - 1 : line_end;
+    }
+};
+
+// =============================================================================
+// TAG=VALUE MESSAGES - FIX-style records, one message per line
+// =============================================================================
+
+/// FIX start-of-header field separator
+inline constexpr char SOH = '\x01';
+
+/// One `tag=value` pair of a message
+struct TagValue {
+    uint32_t tag;
+    FieldRef value;
+};
+
+/// A tokenized tag=value message such as `8=FIX.4.4|9=65|35=D|...`.
+/// Pairs are kept in message order; a small open-addressing table maps each
+/// tag to its first occurrence, so lookups by tag are a hash and a compare.
+/// Repeated tags (repeating groups) remain visible through fields(). Values
+/// point into the parsed text. Reuse one object across messages to keep its
+/// buffers.
+template <char Sep = SOH>
+class TagValueMessage {
+    std::vector<TagValue> fields_;
+    std::vector<uint16_t> table_;  // Field index + 1, 0 = empty
+    uint32_t shift_ = 0;
+
+    static constexpr size_t MIN_TABLE = 32;
+
+    [[nodiscard]] size_t slot_of(uint32_t tag) const noexcept {
+        return static_cast<uint32_t>(tag * 0x9E3779B1u) >> shift_;
+    }
+
+public:
+    static constexpr size_t MAX_FIELDS = std::numeric_limits<uint16_t>::max();
+
+    /// Tokenize one message; a trailing '\r', '\n' or separator is ignored.
+    /// Fails with InvalidInteger for a pair without '=' or a non-numeric tag,
+    /// and OutOfRange beyond MAX_FIELDS pairs.
+    std::expected<size_t, ErrorCode> parse(std::string_view message) {
+        fields_.clear();
+        table_.clear();
+        const char* p = message.data();
+        const char* end = p + message.size();
+        while (end > p && (end[-1] == '\n' || end[-1] == '\r'))
+            --end;
+
+        while (p < end) {
+            const char* pair_end = p + detail::find_field_end(p, end - p, Sep);
+            if (pair_end != p) {
+                const char* eq = p + detail::find_field_end(p, pair_end - p, '=');
+                if (eq == p || eq == pair_end || eq - p > 9)
+                    return std::unexpected(ErrorCode::InvalidInteger);
+                uint32_t tag = 0;
+                for (const char* d = p; d < eq; ++d) {
+                    if (*d < '0' || *d > '9')
+                        return std::unexpected(ErrorCode::InvalidInteger);
+                    tag = tag * 10 + static_cast<uint32_t>(*d - '0');
+                }
+                if (fields_.size() == MAX_FIELDS)
+                    return std::unexpected(ErrorCode::OutOfRange);
+                fields_.push_back(TagValue{tag, FieldRef(eq + 1, pair_end)});
+            }
+            p = pair_end + 1;
+        }
+
+        // Table at most half full
+        size_t capacity = MIN_TABLE;
+        while (capacity < 2 * fields_.size())
+            capacity <<= 1;
+        table_.assign(capacity, 0);
+        shift_ = 32 - static_cast<uint32_t>(std::countr_zero(capacity));
+        const size_t mask = capacity - 1;
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            for (size_t s = slot_of(fields_[i].tag);; s = (s + 1) & mask) {
+                if (table_[s] == 0) {
+                    table_[s] = static_cast<uint16_t>(i + 1);
+                    break;
+                }
+                if (fields_[table_[s] - 1].tag == fields_[i].tag)
+                    break;  // Keep the first occurrence
+            }
+        }
+        return fields_.size();
+    }
+
+    /// Value of the first occurrence of `tag`
+    [[nodiscard]] std::optional<FieldRef> get(uint32_t tag) const noexcept {
+        if (table_.empty())
+            return std::nullopt;
+        const size_t mask = table_.size() - 1;
+        for (size_t s = slot_of(tag); table_[s] != 0; s = (s + 1) & mask) {
+            const TagValue& field = fields_[table_[s] - 1];
+            if (field.tag == tag)
+                return field.value;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] bool has(uint32_t tag) const noexcept { return get(tag).has_value(); }
+
+    /// All pairs in message order, repeated tags included
+    [[nodiscard]] std::span<const TagValue> fields() const noexcept { return fields_; }
+    [[nodiscard]] size_t size() const noexcept { return fields_.size(); }
+};
+
+/// Reads a file of tag=value messages, one per line.
+/// Malformed messages are skipped and recorded in last_error().
+template <char Sep = SOH>
+class TagValueReader {
+    FileSource source_;
+    TagValueMessage<Sep> message_;
+    ErrorInfo last_error_;
+
+public:
+    explicit TagValueReader(const std::string& filepath)
+        : TagValueReader(FileSource(filepath)) {}
+
+    explicit TagValueReader(FileSource source) : source_(std::move(source)) {}
+
+    [[nodiscard]] bool valid() const noexcept { return source_.valid(); }
+
+    /// Iterate over messages
+    /// Callback: void(const TagValueMessage<Sep>&)
+    /// Returns the number of messages delivered
+    template <typename Callback>
+    BLAZECSV_HOT size_t for_each(Callback&& callback) {
+        const char* p = source_.data();
+        const char* const end = p + source_.size();
+        size_t count = 0;
+        uint32_t line = 0;
+        while (p < end) {
+            const char* line_end = p + detail::find_newline(p, end - p);
+            ++line;
+            if (line_end != p && !(line_end - p == 1 && *p == '\r')) {
+                auto parsed = message_.parse(std::string_view(p, line_end - p));
+                if (parsed) {
+                    callback(std::as_const(message_));
+                    ++count;
+                } else {
+                    last_error_ = ErrorInfo{parsed.error(), line, 0};
+                }
+            }
+            p = line_end < end ? line_end + 1 : end;
+        }
+        return count;
+    }
+
+    [[nodiscard]] ErrorInfo last_error() const noexcept { return last_error_; }
+};
+
+// =============================================================================
+// WRITER - Row output with optional parallel block compression
+// =============================================================================
+
+/// Output compression. Every block is an independent frame, so the output is
+/// a valid multi-member gzip / multi-frame zstd / multi-frame LZ4 stream that
+/// can later be split at frame boundaries.
+enum class Codec : uint8_t {
+    None,
+    Gzip,  // BGZF blocks (zlib, BLAZECSV_WITH_ZLIB)
+    Zstd,  // BLAZECSV_WITH_ZSTD
+    Lz4,   // LZ4 frames, BLAZECSV_WITH_LZ4
+};
+
+/// Whether the codec was compiled in
+[[nodiscard]] constexpr bool codec_available(Codec codec) noexcept {
+    switch (codec) {
+        case Codec::None:
+            return true;
+        case Codec::Gzip:
+#ifdef BLAZECSV_WITH_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case Codec::Zstd:
+#ifdef BLAZECSV_WITH_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        case Codec::Lz4:
+#ifdef BLAZECSV_WITH_LZ4
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+namespace detail {
+
+/// Largest BGZF input: keeps a compressed block (plus 26 bytes of framing) under 64 KB
+inline constexpr size_t BGZF_MAX_INPUT = 65280;
+
+/// Empty BGZF block marking end of file
+inline constexpr std::array<unsigned char, 28> BGZF_EOF = {
+    0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00, 0x42, 0x43,
+    0x02, 0x00, 0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+/// Per-thread compression context; compress() appends one self-contained frame
+class BlockCompressor {
+public:
+    BlockCompressor(Codec codec, int level) : codec_(codec), level_(level) {
+#ifdef BLAZECSV_WITH_ZLIB
+        if (codec_ == Codec::Gzip) {
+            // Raw deflate: the gzip header and trailer are written by hand
+            zs_ready_ = deflateInit2(&zs_, level_ < 0 ? Z_DEFAULT_COMPRESSION : level_,
+                                     Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        }
+#endif
+#ifdef BLAZECSV_WITH_ZSTD
+        if (codec_ == Codec::Zstd)
+            cctx_ = ZSTD_createCCtx();
+#endif
+    }
+
+    ~BlockCompressor() {
+#ifdef BLAZECSV_WITH_ZLIB
+        if (zs_ready_)
+            deflateEnd(&zs_);
+#endif
+#ifdef BLAZECSV_WITH_ZSTD
+        ZSTD_freeCCtx(cctx_);
+#endif
+    }
+
+    BlockCompressor(const BlockCompressor&) = delete;
+    BlockCompressor& operator=(const BlockCompressor&) = delete;
+
+    /// Returns false on codec failure
+    bool compress(std::string_view in, std::string& out) {
+        switch (codec_) {
+            case Codec::None:
+                out.append(in);
+                return true;
+            case Codec::Gzip:
+                return gzip(in, out);
+            case Codec::Zstd:
+                return zstd(in, out);
+            case Codec::Lz4:
+                return lz4(in, out);
+        }
+        return false;
+    }
+
+private:
+    Codec codec_;
+    int level_;
+#ifdef BLAZECSV_WITH_ZLIB
+    z_stream zs_{};
+    bool zs_ready_ = false;
+#endif
+#ifdef BLAZECSV_WITH_ZSTD
+    ZSTD_CCtx* cctx_ = nullptr;
+#endif
+
+    static void put_le(std::string& out, size_t pos, uint32_t v, size_t bytes) noexcept {
+        for (size_t i = 0; i < bytes; ++i)
+            out[pos + i] = static_cast<char>((v >> (8 * i)) & 0xff);
+    }
+
+    bool gzip([[maybe_unused]] std::string_view in, [[maybe_unused]] std::string& out) {
+#ifdef BLAZECSV_WITH_ZLIB
+        constexpr size_t HEADER = 18;  // gzip header + 'BC' extra subfield
+        constexpr size_t TRAILER = 8;  // CRC32 + ISIZE
+        if (!zs_ready_ || in.size() > BGZF_MAX_INPUT || deflateReset(&zs_) != Z_OK)
+            return false;
+
+        const size_t base = out.size();
+        const size_t bound = deflateBound(&zs_, static_cast<uLong>(in.size()));
+        out.resize(base + HEADER + bound + TRAILER);
+
+        zs_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+        zs_.avail_in = static_cast<uInt>(in.size());
+        zs_.next_out = reinterpret_cast<Bytef*>(out.data() + base + HEADER);
+        zs_.avail_out = static_cast<uInt>(bound);
+        if (deflate(&zs_, Z_FINISH) != Z_STREAM_END)
+            return false;
+
+        const size_t block_size = HEADER + zs_.total_out + TRAILER;
+        if (block_size > 65536)
+            return false;
+
+        static constexpr unsigned char header[HEADER - 2] = {
+            0x1f, 0x8b, 0x08, 0x04, 0, 0, 0, 0, 0, 0xff, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00};
+        std::memcpy(out.data() + base, header, sizeof(header));
+        put_le(out, base + HEADER - 2, static_cast<uint32_t>(block_size - 1), 2);  // BSIZE
+
+        const size_t tail = base + HEADER + zs_.total_out;
+        const uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(in.data()),
+                                static_cast<uInt>(in.size()));
+        put_le(out, tail, static_cast<uint32_t>(crc), 4);
+        put_le(out, tail + 4, static_cast<uint32_t>(in.size()), 4);
+        out.resize(base + block_size);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool zstd([[maybe_unused]] std::string_view in, [[maybe_unused]] std::string& out) {
+#ifdef BLAZECSV_WITH_ZSTD
+        if (cctx_ == nullptr)
+            return false;
+        const size_t base = out.size();
+        out.resize(base + ZSTD_compressBound(in.size()));
+        const size_t n = ZSTD_compressCCtx(cctx_, out.data() + base, out.size() - base,
+                                           in.data(), in.size(),
+                                           level_ < 0 ? ZSTD_CLEVEL_DEFAULT : level_);
+        if (ZSTD_isError(n))
+            return false;
+        out.resize(base + n);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool lz4([[maybe_unused]] std::string_view in, [[maybe_unused]] std::string& out) {
+#ifdef BLAZECSV_WITH_LZ4
+        LZ4F_preferences_t prefs{};
+        prefs.compressionLevel = level_ < 0 ? 0 : level_;
+        prefs.frameInfo.contentSize = in.size();
+        const size_t base = out.size();
+        out.resize(base + LZ4F_compressFrameBound(in.size(), &prefs));
+        const size_t n = LZ4F_compressFrame(out.data() + base, out.size() - base, in.data(),
+                                            in.size(), &prefs);
+        if (LZ4F_isError(n))
+            return false;
+        out.resize(base + n);
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+}  // namespace detail
+
+/// Buffered CSV writer.
+///
+/// Rows are formatted into blocks cut at row boundaries; a row longer than
+/// the block size gets a block of its own (with gzip, rows over
+/// detail::BGZF_MAX_INPUT bytes must span BGZF blocks). Without a codec each
+/// full block goes straight to the file. With a codec, blocks are compressed
+/// on num_threads workers while the caller keeps formatting, and a writer
+/// thread appends the frames in submission order. At most 2 * num_threads
+/// blocks are in flight; write_row() waits when the workers fall behind.
+///
+/// Fields are written verbatim (the readers do not unquote), so they must
+/// not contain the delimiter or line breaks.
+template <char Delim = ','>
+class Writer {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+
+    /// Gzip clamps block_size to detail::BGZF_MAX_INPUT. level < 0 picks the
+    /// codec's default.
+    explicit Writer(const std::string& path, Codec codec = Codec::None, size_t num_threads = 4,
+                    int level = -1, size_t block_size = DEFAULT_BLOCK_SIZE)
+        : codec_(codec),
+          block_size_(codec == Codec::Gzip ? std::min(block_size, detail::BGZF_MAX_INPUT)
+                                           : std::max<size_t>(block_size, 1)) {
+        if (!codec_available(codec)) {
+            error_ = ErrorCode::CodecUnavailable;
+            return;
+        }
+        file_ = std::fopen(path.c_str(), "wb");
+        if (file_ == nullptr) {
+            error_ = ErrorCode::FileOpenError;
+            return;
+        }
+        buffer_.reserve(block_size_ + 4096);
+
+        if (codec_ != Codec::None) {
+            num_threads = std::max<size_t>(num_threads, 1);
+            slots_.resize(2 * num_threads);
+            ready_.assign(2 * num_threads, 0);
+            jobs_ = std::make_unique<detail::BoundedQueue<Job>>(2 * num_threads);
+            for (size_t i = 0; i < num_threads; ++i)
+                workers_.emplace_back([this, level] { compress_loop(level); });
+            output_ = std::thread([this] { write_loop(); });
+        }
+    }
+
+    ~Writer() { (void)close(); }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return file_ != nullptr && ok(); }
+
+    /// Format one row: strings, FieldRefs, integers, floats and bools (as 1/0)
+    template <typename... Fields>
+    void write_row(const Fields&... fields) {
+        bool first = true;
+        auto one = [&](const auto& field) {
+            if (!first)
+                buffer_.push_back(Delim);
+            first = false;
+            append_field(field);
+        };
+        (one(fields), ...);
+        buffer_.push_back('\n');
+        if (buffer_.size() >= block_size_)
+            flush_blocks(false);
+    }
+
+    /// Row from a runtime list of fields
+    void write_fields(std::span<const std::string_view> fields) {
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (i > 0)
+                buffer_.push_back(Delim);
+            buffer_.append(fields[i]);
+        }
+        buffer_.push_back('\n');
+        if (buffer_.size() >= block_size_)
+            flush_blocks(false);
+    }
+
+    /// Raw bytes, e.g. pre-formatted lines
+    void write(std::string_view bytes) {
+        buffer_.append(bytes);
+        if (buffer_.size() >= block_size_)
+            flush_blocks(false);
+    }
+
+    /// Flush, finish the stream (BGZF end-of-file block for gzip) and close
+    /// the file. Idempotent; reports the first error seen.
+    std::expected<void, ErrorCode> close() {
+        if (file_ != nullptr) {
+            flush_blocks(true);
+            if (codec_ != Codec::None) {
+                jobs_->close();
+                for (auto& t : workers_)
+                    t.join();
+                {
+                    std::lock_guard lock(mutex_);
+                    finished_ = true;
+                }
+                slot_ready_.notify_all();
+                output_.join();
+                workers_.clear();
+            }
+            if (codec_ == Codec::Gzip && ok())
+                put(std::string_view(reinterpret_cast<const char*>(detail::BGZF_EOF.data()),
+                                     detail::BGZF_EOF.size()));
+            if (std::fclose(file_) != 0)
+                set_error(ErrorCode::FileWriteError);
+            file_ = nullptr;
+        }
+        if (!ok())
+            return std::unexpected(error_.load());
+        return {};
+    }
+
+private:
+    struct Job {
+        size_t seq;
+        std::string data;
+    };
+
+    std::FILE* file_ = nullptr;
+    Codec codec_;
+    size_t block_size_;
+    std::string buffer_;
+    std::atomic<ErrorCode> error_{ErrorCode::Ok};
+
+    // Compression pipeline: workers fill slots_[seq % size], output_ drains in order
+    std::unique_ptr<detail::BoundedQueue<Job>> jobs_;
+    std::vector<std::thread> workers_;
+    std::thread output_;
+    std::mutex mutex_;
+    std::condition_variable slot_ready_;
+    std::condition_variable slot_free_;
+    std::vector<std::string> slots_;
+    std::vector<uint8_t> ready_;
+    size_t submitted_ = 0;  // Caller thread only
+    size_t written_ = 0;    // Guarded by mutex_
+    bool finished_ = false;
+
+    [[nodiscard]] bool ok() const noexcept { return error_.load() == ErrorCode::Ok; }
+
+    void set_error(ErrorCode code) noexcept {
+        ErrorCode expected = ErrorCode::Ok;
+        error_.compare_exchange_strong(expected, code);
+    }
+
+    void append_field(std::string_view s) { buffer_.append(s); }
+    void append_field(const char* s) { buffer_.append(s); }
+    void append_field(const std::string& s) { buffer_.append(s); }
+    void append_field(const FieldRef& f) { buffer_.append(f.view()); }
+    void append_field(bool b) { buffer_.push_back(b ? '1' : '0'); }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void append_field(T value) {
+        char tmp[64];
+        auto [ptr, ec] = std::to_chars(tmp, tmp + sizeof(tmp), value);
+        buffer_.append(tmp, ec == std::errc{} ? ptr : tmp);
+    }
+
+    void put(std::string_view bytes) {
+        if (!bytes.empty() && std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size())
+            set_error(ErrorCode::FileWriteError);
+    }
+
+    /// Hand off full blocks (everything when final), cutting after the last
+    /// newline that fits so blocks hold whole rows
+    void flush_blocks(bool final) {
+        if (file_ == nullptr) {
+            buffer_.clear();
+            return;
+        }
+        size_t pos = 0;
+        while (buffer_.size() - pos >= block_size_ || (final && pos < buffer_.size())) {
+            const std::string_view rest = std::string_view(buffer_).substr(pos);
+            size_t len = std::min(block_size_, rest.size());
+            if (len == block_size_) {
+                size_t nl = rest.substr(0, len).rfind('\n');
+                if (nl == std::string_view::npos) {
+                    // A row longer than a block: extend the block to the row's end,
+                    // up to the largest input a BGZF block can hold
+                    const size_t cap =
+                        codec_ == Codec::Gzip ? detail::BGZF_MAX_INPUT : rest.size();
+                    nl = rest.substr(0, cap).find('\n', len);
+                    if (nl == std::string_view::npos) {
+                        if (cap < rest.size())
+                            nl = cap - 1;  // Too long for BGZF: the row spans blocks
+                        else if (final)
+                            nl = rest.size() - 1;
+                        else
+                            break;  // Wait for the rest of the row
+                    }
+                }
+                len = nl + 1;
+            }
+            submit(rest.substr(0, len));
+            pos += len;
+        }
+        buffer_.erase(0, pos);
+    }
+
+    void submit(std::string_view block) {
+        if (codec_ == Codec::None) {
+            put(block);
+            return;
+        }
+        const size_t seq = submitted_++;
+        {
+            std::unique_lock lock(mutex_);
+            slot_free_.wait(lock, [&] { return seq - written_ < slots_.size(); });
+        }
+        jobs_->push(Job{seq, std::string(block)});
+    }
+
+    void compress_loop(int level) {
+        detail::BlockCompressor compressor(codec_, level);
+        while (auto job = jobs_->pop()) {
+            std::string frame;
+            if (!compressor.compress(job->data, frame))
+                set_error(ErrorCode::FileWriteError);
+            const size_t slot = job->seq % slots_.size();
+            {
+                std::lock_guard lock(mutex_);
+                slots_[slot] = std::move(frame);
+                ready_[slot] = 1;
+            }
+            slot_ready_.notify_all();
+        }
+    }
+
+    void write_loop() {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            const size_t slot = written_ % slots_.size();
+            slot_ready_.wait(lock, [&] { return ready_[slot] || finished_; });
+            if (!ready_[slot])
+                return;  // Finished and drained
+
+            std::string frame = std::move(slots_[slot]);
+            ready_[slot] = 0;
+            lock.unlock();
+            if (ok())
+                put(frame);
+            lock.lock();
+            ++written_;
+            slot_free_.notify_one();
+        }
+    }
+};
+
+// =============================================================================
+// VALIDATION - Declarative data-quality rules checked in one parallel pass
+// =============================================================================
+
+/// A data-quality rule
+enum class Rule : uint8_t {
+    ColumnCount,  // Row does not have exactly Columns fields
+    NotNull,
+    Type,
+    Range,
+    OneOf,
+    MaxLength,
+    Monotonic,
+    Unique,
+};
+
+inline constexpr size_t RULE_COUNT = 8;
+
+/// Expected field type for Rule::Type
+enum class ColumnType : uint8_t { String, Integer, Number, Date, DateTime };
+
+/// One failed check
+struct Violation {
+    static constexpr uint32_t WHOLE_ROW = std::numeric_limits<uint32_t>::max();
+
+    size_t row;         // 1-based data row: non-empty lines after the header
+    uint32_t column;    // WHOLE_ROW for Rule::ColumnCount
+    Rule rule;
+    std::string value;  // The offending field, or the whole line for Rule::ColumnCount
+};
+
+/// Rule set for one column.
+/// Null fields (per the validator's NullPol) fail only not_null(); every
+/// other rule skips them. Typed rules (type, range, monotonic) convert each
+/// field once.
+class ColumnRules {
+public:
+    ColumnRules& not_null() noexcept {
+        rules_ |= bit(Rule::NotNull);
+        return *this;
+    }
+
+    /// Field must convert to the type (parse<int64_t>, parse<double>,
+    /// parse_date, parse_datetime)
+    ColumnRules& type(ColumnType t) noexcept {
+        type_ = t;
+        if (t != ColumnType::String)
+            rules_ |= bit(Rule::Type);
+        return *this;
+    }
+
+    /// Inclusive numeric range. A column without a type becomes a Number column.
+    ColumnRules& range(double min, double max) noexcept {
+        if (type_ == ColumnType::String)
+            type(ColumnType::Number);
+        min_ = min;
+        max_ = max;
+        rules_ |= bit(Rule::Range);
+        return *this;
+    }
+
+    /// Field must equal one of the values (bytewise)
+    ColumnRules& one_of(std::initializer_list<std::string_view> values) {
+        allowed_.assign(values.begin(), values.end());
+        std::sort(allowed_.begin(), allowed_.end());
+        rules_ |= bit(Rule::OneOf);
+        return *this;
+    }
+
+    /// At most n bytes
+    ColumnRules& max_length(size_t n) noexcept {
+        max_length_ = n;
+        rules_ |= bit(Rule::MaxLength);
+        return *this;
+    }
+
+    /// Non-decreasing (strict: increasing) in file order. Compares converted
+    /// values for typed columns and bytes for String columns.
+    ColumnRules& monotonic(bool strict = false) noexcept {
+        strict_ = strict;
+        rules_ |= bit(Rule::Monotonic);
+        return *this;
+    }
+
+    /// No value may repeat anywhere in the file
+    ColumnRules& unique() noexcept {
+        rules_ |= bit(Rule::Unique);
+        return *this;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return rules_ == 0; }
+
+private:
+    template <size_t, char, typename>
+    friend class Validator;
+
+    static constexpr uint32_t bit(Rule r) noexcept { return 1u << static_cast<uint32_t>(r); }
+
+    [[nodiscard]] bool has(Rule r) const noexcept { return (rules_ & bit(r)) != 0; }
+
+    uint32_t rules_ = 0;
+    ColumnType type_ = ColumnType::String;
+    bool strict_ = false;
+    double min_ = 0;
+    double max_ = 0;
+    size_t max_length_ = 0;
+    std::vector<std::string> allowed_;  // Sorted
+};
+
+/// Result of Validator::run()
+struct ValidationReport {
+    size_t rows = 0;             // Data rows checked, including malformed ones
+    size_t malformed_rows = 0;   // Rule::ColumnCount failures
+    size_t violation_count = 0;  // All failures, including those not kept below
+    std::vector<Violation> violations;                   // Earliest, in row order
+    std::vector<std::array<size_t, RULE_COUNT>> counts;  // [column][rule]
+
+    [[nodiscard]] bool ok() const noexcept { return violation_count == 0; }
+
+    /// Failures of one rule in one column
+    [[nodiscard]] size_t count(size_t column, Rule rule) const noexcept {
+        return column < counts.size() ? counts[column][static_cast<size_t>(rule)] : 0;
+    }
+};
+
+/// Checks a file against per-column rules in one ParallelReader pass.
+///
+/// Rules are compiled into a list of checkers for the columns that have any,
+/// so unconstrained columns cost nothing. Each chunk thread keeps its own
+/// violations, counters, first/last monotonic values and unique-key table;
+/// they are merged after the pass, which also checks monotonicity and
+/// uniqueness across chunk boundaries.
+template <size_t Columns, char Delim = ',', typename NullPol = NullStandard>
+class Validator {
+public:
+    ColumnRules& column(size_t index) noexcept { return columns_[index]; }
+
+    /// Validate every row of the reader. Keeps the first max_violations
+    /// violations in the report; counts cover all of them.
+    ValidationReport run(ParallelReader<Columns, Delim, NullPol>& reader,
+                         size_t max_violations = 1000) const {
+        std::vector<Check> checks;
+        for (size_t c = 0; c < Columns; ++c) {
+            if (!columns_[c].empty())
+                checks.push_back({static_cast<uint32_t>(c), &columns_[c]});
+        }
+
+        std::vector<ChunkResult> chunks(reader.num_threads());
+        for (auto& chunk : chunks) {
+            chunk.counts.assign(checks.size(), {});
+            chunk.first.resize(checks.size());
+            chunk.last.resize(checks.size());
+            chunk.seen.resize(checks.size());
+        }
+
+        size_t num_chunks = reader.for_each_chunk([&](size_t index, const char* begin,
+                                                      const char* end) {
+            check_chunk(checks, begin, end, max_violations, chunks[index]);
+            return chunks[index].rows;
+        });
+        chunks.resize(num_chunks);
+
+        return merge(checks, chunks, max_violations);
+    }
+
+private:
+    /// Comparable converted value of a field
+    struct Key {
+        int64_t i = 0;
+        double d = 0;
+        std::string_view text;
+    };
+
+    struct Mark {
+        Key key;
+        size_t row;
+    };
+
+    struct Check {
+        uint32_t column;
+        const ColumnRules* rules;
+    };
+
+    struct ChunkResult {
+        size_t rows = 0;
+        size_t malformed = 0;
+        size_t total = 0;
+        std::vector<Violation> violations;  // Local row numbers
+        std::vector<std::array<size_t, RULE_COUNT>> counts;
+        std::vector<std::optional<Mark>> first;  // Per check: first / last monotonic value
+        std::vector<std::optional<Mark>> last;
+        std::vector<std::unordered_map<std::string_view, size_t>> seen;  // Key -> first row
+    };
+
+    std::array<ColumnRules, Columns> columns_{};
+
+    static void record(ChunkResult& out, size_t max_violations, size_t row, uint32_t column,
+                       Rule rule, std::string_view value) {
+        ++out.total;
+        if (out.violations.size() < max_violations)
+            out.violations.push_back({row, column, rule, std::string(value)});
+    }
+
+    static std::optional<Key> convert(const FieldRef& field, ColumnType type) noexcept {
+        Key key;
+        key.text = field.view();
+        switch (type) {
+            case ColumnType::String:
+                return key;
+            case ColumnType::Integer: {
+                auto v = field.parse<int64_t>();
+                if (!v)
+                    return std::nullopt;
+                key.i = *v;
+                key.d = static_cast<double>(*v);
+                return key;
+            }
+            case ColumnType::Number: {
+                auto v = field.parse<double>();
+                if (!v)
+                    return std::nullopt;
+                key.d = *v;
+                return key;
+            }
+            case ColumnType::Date: {
+                auto v = field.parse_date();
+                if (!v)
+                    return std::nullopt;
+                key.i = std::chrono::sys_days(*v).time_since_epoch().count();
+                key.d = static_cast<double>(key.i);
+                return key;
+            }
+            case ColumnType::DateTime: {
+                auto v = field.parse_datetime();
+                if (!v)
+                    return std::nullopt;
+                key.i = v->time_since_epoch().count();
+                key.d = static_cast<double>(key.i);
+                return key;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// True when b may not follow a under the monotonic rule
+    static bool out_of_order(const Key& a, const Key& b, ColumnType type, bool strict) noexcept {
+        switch (type) {
+            case ColumnType::String:
+                return strict ? b.text <= a.text : b.text < a.text;
+            case ColumnType::Number:
+                return strict ? b.d <= a.d : b.d < a.d;
+            default:
+                return strict ? b.i <= a.i : b.i < a.i;
+        }
+    }
+
+    static void check_chunk(const std::vector<Check>& checks, const char* begin, const char* end,
+                            size_t max_violations, ChunkResult& out) {
+        ParallelReader<Columns, Delim, NullPol>::scan_lines(begin, end, [&](const char** starts,
+                                                                            const char** ends,
+                                                                            size_t found) {
+            const size_t row = ++out.rows;
+
+            // split_fields stops at Columns; a delimiter after the last field means more
+            if (found != Columns || (ends[Columns - 1] < end && *ends[Columns - 1] == Delim)) {
+                ++out.malformed;
+                size_t len = detail::find_newline(starts[0], end - starts[0]);
+                if (len > 0 && starts[0][len - 1] == '\r')
+                    --len;
+                record(out, max_violations, row, Violation::WHOLE_ROW, Rule::ColumnCount,
+                       std::string_view(starts[0], len));
+                return;
+            }
+
+            for (size_t k = 0; k < checks.size(); ++k) {
+                const uint32_t c = checks[k].column;
+                const ColumnRules& rules = *checks[k].rules;
+                const FieldRef field(starts[c], ends[c]);
+                auto fail = [&](Rule rule) {
+                    ++out.counts[k][static_cast<size_t>(rule)];
+                    record(out, max_violations, row, c, rule, field.view());
+                };
+
+                if (field.template is_null<NullPol>()) {
+                    if (rules.has(Rule::NotNull))
+                        fail(Rule::NotNull);
+                    continue;
+                }
+
+                if (rules.has(Rule::MaxLength) && field.size() > rules.max_length_)
+                    fail(Rule::MaxLength);
+
+                if (rules.has(Rule::OneOf) && !std::binary_search(rules.allowed_.begin(),
+                                                                  rules.allowed_.end(),
+                                                                  field.view()))
+                    fail(Rule::OneOf);
+
+                if (rules.has(Rule::Type) || rules.has(Rule::Range) ||
+                    rules.has(Rule::Monotonic)) {
+                    auto key = convert(field, rules.type_);
+                    if (!key) {
+                        fail(Rule::Type);
+                    } else {
+                        if (rules.has(Rule::Range) && (key->d < rules.min_ || key->d > rules.max_))
+                            fail(Rule::Range);
+
+                        if (rules.has(Rule::Monotonic)) {
+                            auto& last = out.last[k];
+                            if (last && out_of_order(last->key, *key, rules.type_, rules.strict_))
+                                fail(Rule::Monotonic);
+                            last = Mark{*key, row};
+                            if (!out.first[k])
+                                out.first[k] = last;
+                        }
+                    }
+                }
+
+                if (rules.has(Rule::Unique) && !out.seen[k].try_emplace(field.view(), row).second)
+                    fail(Rule::Unique);
+            }
+        });
+    }
+
+    static ValidationReport merge(const std::vector<Check>& checks,
+                                  std::vector<ChunkResult>& chunks, size_t max_violations) {
+        ValidationReport report;
+        report.counts.assign(Columns, {});
+
+        // Local -> global row numbers
+        std::vector<size_t> row_base(chunks.size(), 0);
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            row_base[i] = report.rows;
+            report.rows += chunks[i].rows;
+            report.malformed_rows += chunks[i].malformed;
+            report.violation_count += chunks[i].total;
+            for (auto& v : chunks[i].violations) {
+                v.row += row_base[i];
+                report.violations.push_back(std::move(v));
+            }
+            for (size_t k = 0; k < checks.size(); ++k) {
+                for (size_t r = 0; r < RULE_COUNT; ++r)
+                    report.counts[checks[k].column][r] += chunks[i].counts[k][r];
+            }
+        }
+
+        auto fail = [&](size_t k, Rule rule, size_t row, std::string_view value) {
+            ++report.violation_count;
+            ++report.counts[checks[k].column][static_cast<size_t>(rule)];
+            report.violations.push_back({row, checks[k].column, rule, std::string(value)});
+        };
+
+        // Checks that span chunk boundaries
+        for (size_t k = 0; k < checks.size(); ++k) {
+            const ColumnRules& rules = *checks[k].rules;
+
+            if (rules.has(Rule::Monotonic)) {
+                std::optional<Mark> prev;
+                for (size_t i = 0; i < chunks.size(); ++i) {
+                    const auto& first = chunks[i].first[k];
+                    if (prev && first &&
+                        out_of_order(prev->key, first->key, rules.type_, rules.strict_))
+                        fail(k, Rule::Monotonic, row_base[i] + first->row, first->key.text);
+                    if (chunks[i].last[k])
+                        prev = chunks[i].last[k];
+                }
+            }
+
+            if (rules.has(Rule::Unique)) {
+                // Each chunk already flagged its own repeats; flag first occurrences
+                // in a chunk that an earlier chunk has seen
+                for (size_t i = 1; i < chunks.size(); ++i) {
+                    for (const auto& [value, row] : chunks[i].seen[k]) {
+                        for (size_t j = 0; j < i; ++j) {
+                            if (chunks[j].seen[k].contains(value)) {
+                                fail(k, Rule::Unique, row_base[i] + row, value);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        std::sort(report.violations.begin(), report.violations.end(),
+                  [](const Violation& a, const Violation& b) {
+                      if (a.row != b.row)
+                          return a.row < b.row;
+                      return a.column != b.column ? a.column < b.column : a.rule < b.rule;
+                  });
+        if (report.violations.size() > max_violations)
+            report.violations.resize(max_violations);
+        return report;
+    }
+};
+
+// =============================================================================
+// SHARED SCAN - One tokenization pass feeding many consumers
+// =============================================================================
+
+namespace detail {
+
+/// Type-erased SharedScan consumer; batches arrive from several threads,
+/// each chunk index from exactly one
+template <size_t Columns>
+class ScanConsumer {
+public:
+    using Row = std::array<FieldRef, Columns>;
+
+    virtual ~ScanConsumer() = default;
+    virtual void begin(size_t max_chunks) = 0;
+    virtual void on_batch(size_t chunk, std::span<const Row> rows) = 0;
+    virtual void finish(size_t chunks) = 0;
+};
+
+template <size_t Columns, typename Callback>
+class CallbackConsumer final : public ScanConsumer<Columns> {
+    using Row = typename ScanConsumer<Columns>::Row;
+    Callback callback_;
+
+public:
+    explicit CallbackConsumer(Callback callback) : callback_(std::move(callback)) {}
+
+    void begin(size_t) override {}
+    void on_batch(size_t, std::span<const Row> rows) override {
+        for (const auto& row : rows)
+            callback_(row);
+    }
+    void finish(size_t) override {}
+};
+
+template <size_t Columns, typename State, typename Accumulate, typename Merge>
+class ReducerConsumer final : public ScanConsumer<Columns> {
+    using Row = typename ScanConsumer<Columns>::Row;
+
+    // One cache line apart so workers never share one
+    struct alignas(64) Slot {
+        State state;
+    };
+
+    State init_;
+    Accumulate accumulate_;
+    Merge merge_;
+    std::vector<Slot> partial_;
+    std::shared_ptr<State> result_;
+
+public:
+    ReducerConsumer(State init, Accumulate accumulate, Merge merge,
+                    std::shared_ptr<State> result)
+        : init_(std::move(init)),
+          accumulate_(std::move(accumulate)),
+          merge_(std::move(merge)),
+          result_(std::move(result)) {}
+
+    void begin(size_t max_chunks) override { partial_.assign(max_chunks, Slot{init_}); }
+
+    void on_batch(size_t chunk, std::span<const Row> rows) override {
+        State& state = partial_[chunk].state;
+        for (const auto& row : rows)
+            accumulate_(state, row);
+    }
+
+    /// Merge per-chunk states in file order
+    void finish(size_t chunks) override {
+        State total = init_;
+        for (size_t i = 0; i < chunks; ++i)
+            merge_(total, std::move(partial_[i].state));
+        *result_ = std::move(total);
+        partial_.clear();
+    }
+};
+
+}  // namespace detail
+
+/// Final state of a SharedScan reducer, available after run()
+template <typename State>
+class ScanResult {
+public:
+    explicit ScanResult(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    [[nodiscard]] const State& get() const noexcept { return *state_; }
+    [[nodiscard]] const State& operator*() const noexcept { return *state_; }
+    [[nodiscard]] const State* operator->() const noexcept { return state_.get(); }
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+/// Runs many independent consumers over a single parallel parse.
+///
+/// Each worker tokenizes its chunk into batches of BATCH_ROWS rows and offers
+/// every batch to every consumer in registration order while it is still hot
+/// in cache. Reducers keep one state per worker, merged in file order after
+/// the pass, so they need no synchronization. Rows whose field count is not
+/// Columns are skipped, as in for_each_parallel().
+template <size_t Columns, char Delim = ',', typename NullPol = NullStandard>
+class SharedScan {
+public:
+    using Row = std::array<FieldRef, Columns>;
+
+    static constexpr size_t BATCH_ROWS = 256;
+
+    explicit SharedScan(ParallelReader<Columns, Delim, NullPol>& reader) : reader_(reader) {}
+
+    /// Per-row callback, invoked concurrently from worker threads
+    /// Callback: void(const std::array<FieldRef, Columns>&)
+    template <typename Callback>
+    void add(Callback&& callback) {
+        consumers_.push_back(
+            std::make_unique<detail::CallbackConsumer<Columns, std::decay_t<Callback>>>(
+                std::forward<Callback>(callback)));
+    }
+
+    /// Reducer with per-thread state
+    /// Accumulate: void(State&, const std::array<FieldRef, Columns>&)
+    /// Merge: void(State& into, State&& from)
+    template <typename State, typename Accumulate, typename Merge>
+    ScanResult<State> add_reducer(State init, Accumulate&& accumulate, Merge&& merge) {
+        auto result = std::make_shared<State>(init);
+        consumers_.push_back(
+            std::make_unique<detail::ReducerConsumer<Columns, State, std::decay_t<Accumulate>,
+                                                     std::decay_t<Merge>>>(
+                std::move(init), std::forward<Accumulate>(accumulate),
+                std::forward<Merge>(merge), result));
+        return ScanResult<State>(std::move(result));
+    }
+
+    [[nodiscard]] size_t consumer_count() const noexcept { return consumers_.size(); }
+
+    /// Parse the file once, feeding every consumer. Returns the number of rows.
+    size_t run() {
+        const size_t max_chunks = reader_.num_threads();
+        for (auto& consumer : consumers_)
+            consumer->begin(max_chunks);
+
+        std::vector<size_t> rows(max_chunks, 0);
+        size_t chunks = reader_.for_each_chunk([&](size_t chunk, const char* begin,
+                                                   const char* end) {
+            std::vector<Row> batch;
+            batch.reserve(BATCH_ROWS);
+            size_t count = 0;
+
+            auto offer = [&] {
+                BLAZECSV_PROBE2(batch, chunk, batch.size());
+                for (auto& consumer : consumers_)
+                    consumer->on_batch(chunk, batch);
+                count += batch.size();
+                batch.clear();
+            };
+
+            ParallelReader<Columns, Delim, NullPol>::scan_lines(
+                begin, end, [&](const char** starts, const char** ends, size_t col) {
+                    if (col != Columns)
+                        return;
+                    Row& row = batch.emplace_back();
+                    for (size_t i = 0; i < Columns; ++i)
+                        row[i] = FieldRef(starts[i], ends[i]);
+                    if (batch.size() == BATCH_ROWS)
+                        offer();
+                });
+            if (!batch.empty())
+                offer();
+            rows[chunk] = count;
+            return count;
+        });
+
+        for (auto& consumer : consumers_)
+            consumer->finish(chunks);
+
+        size_t total = 0;
+        for (size_t r : rows)
+            total += r;
+        return total;
+    }
+
+private:
+    ParallelReader<Columns, Delim, NullPol>& reader_;
+    std::vector<std::unique_ptr<detail::ScanConsumer<Columns>>> consumers_;
+};
+
+// =============================================================================
+// HASH INDEX - Persistent key -> row offset sidecar for point lookups
+// =============================================================================
+
+namespace detail {
+
+/// Stable 64-bit hash for persisted indexes (FNV-1a with a murmur3 finalizer
+/// so the low bits used for slot selection are well mixed)
+[[nodiscard]] inline uint64_t stable_hash(std::string_view key) noexcept {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/// Field `column` of the line starting at `line` (terminator and CR excluded);
+/// nullopt if the line has fewer fields
+template <char Delim>
+[[nodiscard]] inline std::optional<std::string_view> nth_field(const char* line,
+                                                               const char* end,
+                                                               size_t column) noexcept {
+    const char* line_end = line + find_newline(line, end - line);
+    if (line_end > line && *(line_end - 1) == '\r')
+        --line_end;
+    const char* ptr = line;
+    for (size_t col = 0;; ++col) {
+        const char* field_end = ptr + find_field_end(ptr, line_end - ptr, Delim);
+        if (col == column)
+            return std::string_view(ptr, field_end - ptr);
+        if (field_end >= line_end)
+            return std::nullopt;
+        ptr = field_end + 1;
+    }
+}
+
+}  // namespace detail
+
+/// Open-addressing hash table from key-column hash to row byte offset,
+/// stored next to the CSV and memory-mapped for lookups.
+///
+/// Layout: a 64-byte header, then a power-of-two array of {hash, offset}
+/// slots at most half full, probed linearly. A lookup touches the header,
+/// usually one slot page and the matching row's page; hash collisions are
+/// resolved by comparing the key against the CSV bytes. Duplicate keys are
+/// all returned. An index is rejected as stale unless the CSV's size,
+/// modification time and a hash of its first and last 4 KB all still match.
+template <char Delim = ','>
+class HashIndex {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    /// Index column `key_column` of csv_path into index_path.
+    /// Returns the number of rows indexed.
+    static std::expected<size_t, ErrorCode> build(const std::string& csv_path, size_t key_column,
+                                                  const std::string& index_path,
+                                                  bool skip_header = true) {
+        MmapSource csv(csv_path);
+        if (!csv.valid())
+            return std::unexpected(ErrorCode::FileOpenError);
+        const char* const base = csv.data();
+        const char* const end = base + csv.size();
+
+        // Newline count bounds the row count, which sizes the table
+        size_t lines = 0;
+        for (const char* p = base; p < end; ++lines) {
+            const void* nl = std::memchr(p, '\n', end - p);
+            p = nl ? static_cast<const char*>(nl) + 1 : end;
+        }
+        size_t slot_count = 16;
+        while (slot_count < 2 * lines)
+            slot_count <<= 1;
+
+        std::vector<Slot> slots(slot_count, Slot{0, EMPTY});
+        const uint64_t mask = slot_count - 1;
+        size_t entries = 0;
+
+        const char* line = base;
+        if (skip_header && line < end)
+            line = next_line(line, end);
+        for (; line < end; line = next_line(line, end)) {
+            if (*line == '\n' || *line == '\r')
+                continue;
+            auto key = detail::nth_field<Delim>(line, end, key_column);
+            if (!key)
+                continue;
+            const uint64_t h = detail::stable_hash(*key);
+            uint64_t i = h & mask;
+            while (slots[i].offset != EMPTY)
+                i = (i + 1) & mask;
+            slots[i] = Slot{h, static_cast<uint64_t>(line - base)};
+            ++entries;
+        }
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.key_column = static_cast<uint32_t>(key_column);
+        header.delimiter = static_cast<uint8_t>(Delim);
+        header.slot_count = slot_count;
+        header.entry_count = entries;
+        header.csv_size = csv.size();
+        header.csv_mtime = modification_time(csv_path);
+        header.csv_fingerprint = fingerprint(base, csv.size());
+
+        std::FILE* out = std::fopen(index_path.c_str(), "wb");
+        if (out == nullptr)
+            return std::unexpected(ErrorCode::FileOpenError);
+        bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+                  std::fwrite(slots.data(), sizeof(Slot), slots.size(), out) == slots.size();
+        ok = (std::fclose(out) == 0) && ok;
+        if (!ok)
+            return std::unexpected(ErrorCode::FileWriteError);
+        return entries;
+    }
+
+    /// Map a CSV and its index
+    HashIndex(const std::string& csv_path, const std::string& index_path)
+        : csv_(csv_path), index_(index_path) {
+        if (!csv_.valid() || !index_.valid() || index_.size() < sizeof(Header))
+            return;
+        const auto* header = reinterpret_cast<const Header*>(index_.data());
+        const uint64_t n = header->slot_count;
+        if (std::memcmp(header->magic, MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != VERSION || header->delimiter != static_cast<uint8_t>(Delim) ||
+            header->csv_size != csv_.size() || n == 0 || (n & (n - 1)) != 0 ||
+            header->entry_count >= n || index_.size() != sizeof(Header) + n * sizeof(Slot) ||
+            header->csv_mtime != modification_time(csv_path) ||
+            header->csv_fingerprint != fingerprint(csv_.data(), csv_.size()))
+            return;
+        header_ = header;
+        slots_ = reinterpret_cast<const Slot*>(index_.data() + sizeof(Header));
+#if !defined(_WIN32)
+        // Point lookups: no sequential readahead
+        ::madvise(const_cast<char*>(csv_.data()), csv_.size(), MADV_RANDOM);
+        ::madvise(const_cast<char*>(index_.data()), index_.size(), MADV_RANDOM);
+#endif
+    }
+
+    /// Index present, well-formed and built for this CSV
+    [[nodiscard]] bool valid() const noexcept { return header_ != nullptr; }
+
+    [[nodiscard]] size_t size() const noexcept { return valid() ? header_->entry_count : 0; }
 
-        if (p >= end_)
-            return false;
+    [[nodiscard]] size_t key_column() const noexcept {
+        return valid() ? header_->key_column : 0;
+    }
 
-        uint64_t int_part = 0;
-        while (p < end_ && *p >= '0' && *p <= '9') {
-            int_part = int_part * 10 + (*p - '0');
-            ++p;
+    /// Visit every row whose key column equals key
+    /// Callback: void(uint64_t row_offset, std::string_view line)
+    /// Returns the number of matches
+    template <typename Callback>
+    size_t for_each_match(std::string_view key, Callback&& callback) const {
+        if (!valid())
+            return 0;
+        const uint64_t h = detail::stable_hash(key);
+        const uint64_t mask = header_->slot_count - 1;
+        const char* const base = csv_.data();
+        const char* const end = base + csv_.size();
+
+        size_t matches = 0;
+        // Bounded as well, in case a damaged file has no free slot
+        uint64_t i = h & mask;
+        for (uint64_t probes = 0; probes <= mask && slots_[i].offset != EMPTY;
+             ++probes, i = (i + 1) & mask) {
+            if (slots_[i].hash != h || slots_[i].offset >= csv_.size())
+                continue;
+            const char* line = base + slots_[i].offset;
+            auto field = detail::nth_field<Delim>(line, end, header_->key_column);
+            if (!field || *field != key)
+                continue;
+            const char* line_end = line + detail::find_newline(line, end - line);
+            if (line_end > line && *(line_end - 1) == '\r')
+                --line_end;
+            callback(slots_[i].offset, std::string_view(line, line_end - line));
+            ++matches;
         }
+        return matches;
+    }
 
-        x = static_cast<T>(int_part);
+    /// Matching rows (views into the mapped CSV, valid while the index lives)
+    [[nodiscard]] std::vector<std::string_view> lookup(std::string_view key) const {
+        std::vector<std::string_view> rows;
+        for_each_match(key, [&](uint64_t, std::string_view line) { rows.push_back(line); });
+        return rows;
+    }
 
-        if (p < end_ && *p == '.') {
-            ++p;
-            T frac = 0.0;
-            T scale = static_cast<T>(0.1);
-            while (p < end_ && *p >= '0' && *p <= '9') {
-                frac += (*p - '0') * scale;
-                scale *= static_cast<T>(0.1);
-                ++p;
-            }
-            x += frac;
-        }
+private:
+    static constexpr char MAGIC[8] = {'B', 'L', 'Z', 'H', 'I', 'D', 'X', '\0'};
+    static constexpr uint64_t EMPTY = std::numeric_limits<uint64_t>::max();
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t key_column;
+        uint8_t delimiter;
+        uint8_t reserved[7];
+        uint64_t slot_count;
+        uint64_t entry_count;
+        uint64_t csv_size;
+        uint64_t csv_mtime;        // Filesystem clock ticks
+        uint64_t csv_fingerprint;  // See fingerprint()
+    };
+    static_assert(sizeof(Header) == 64);
+
+    struct Slot {
+        uint64_t hash;
+        uint64_t offset;  // Row start; EMPTY marks a free slot
+    };
+    static_assert(sizeof(Slot) == 16);
+
+    MmapSource csv_;
+    MmapSource index_;
+    const Header* header_ = nullptr;
+    const Slot* slots_ = nullptr;
+
+    /// Catches same-size rewrites that keep the modification time
+    [[nodiscard]] static uint64_t fingerprint(const char* data, size_t size) noexcept {
+        const size_t span = std::min<size_t>(size, 4096);
+        return detail::stable_hash(std::string_view(data, span)) ^
+               std::rotl(detail::stable_hash(std::string_view(data + size - span, span)), 1);
+    }
 
-        if (negative)
-            x = -x;
-        return p == end_;
+    [[nodiscard]] static uint64_t modification_time(const std::string& path) noexcept {
+        std::error_code ec;
+        const auto time = std::filesystem::last_write_time(path, ec);
+        return ec ? 0 : static_cast<uint64_t>(time.time_since_epoch().count());
+    }
+
+    [[nodiscard]] static const char* next_line(const char* line, const char* end) noexcept {
+        const char* nl = line + detail::find_newline(line, end - line);
+        return nl < end ? nl + 1 : end;
     }
 };
 
 // =============================================================================
-// CSV READER - SIMD-ACCELERATED (Main Interface)
+// INCREMENTAL SCAN - Running reducers over an append-only file
 // =============================================================================
 
-template <size_t Columns, char Delim = ',', typename ErrorPolicy = NoErrorCheck,
-          typename NullPol = NullStandard>
-class alignas(64) Reader {  // Cache-line aligned
-    MmapSource source_;
-    const char* current_;
-    const char* end_;
+namespace detail {
 
-    // Header storage - string_views into mmap (zero-copy)
-    std::array<std::string_view, Columns> column_names_;
-    bool header_parsed_ = false;
+/// Read up to `size` bytes at `offset` of `path` into `out`; false if the
+/// file cannot be opened. A short read (file shrank meanwhile) is not an error.
+inline bool read_range(const std::string& path, uint64_t offset, size_t size, std::string& out) {
+    out.resize(size);
+    size_t total = 0;
+#if defined(_WIN32)
+    HANDLE h = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER pos;
+    pos.QuadPart = static_cast<LONGLONG>(offset);
+    if (SetFilePointerEx(h, pos, nullptr, FILE_BEGIN)) {
+        while (total < size) {
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(size - total, 1u << 30));
+            DWORD got = 0;
+            if (!ReadFile(h, out.data() + total, chunk, &got, nullptr) || got == 0)
+                break;
+            total += got;
+        }
+    }
+    CloseHandle(h);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    while (total < size) {
+        ssize_t got = ::pread(fd, out.data() + total, size - total,
+                              static_cast<off_t>(offset + total));
+        if (got <= 0)
+            break;
+        total += static_cast<size_t>(got);
+    }
+    ::close(fd);
+#endif
+    out.resize(total);
+    return true;
+}
 
-    // Prefetch distances
-    static constexpr size_t PREFETCH_L1 = 64;    // One cache line
-    static constexpr size_t PREFETCH_L2 = 4096;  // One page
+/// Type-erased IncrementalScan reducer with a byte codec for its state
+template <size_t Columns>
+class IncrementalReducer {
+public:
+    using Row = std::array<FieldRef, Columns>;
 
-    // Empty placeholder for disabled features (MSVC-compatible)
-    struct Empty {};
+    virtual ~IncrementalReducer() = default;
+    virtual void reset() = 0;
+    virtual void on_batch(std::span<const Row> rows) = 0;
+    virtual void save(std::string& out) const = 0;
+    virtual bool load(std::string_view in) = 0;
+};
 
-    // Error tracking (only if enabled - zero bytes otherwise via [[no_unique_address]])
-    [[no_unique_address]] std::conditional_t<ErrorPolicy::enabled, ErrorInfo, Empty> last_error_{};
-    [[no_unique_address]] std::conditional_t<ErrorPolicy::track_line, uint32_t, Empty>
-        line_number_{};
+template <size_t Columns, typename State, typename Accumulate, typename Save, typename Load>
+class CodecReducer final : public IncrementalReducer<Columns> {
+    using Row = typename IncrementalReducer<Columns>::Row;
+
+    State init_;
+    Accumulate accumulate_;
+    Save save_;
+    Load load_;
+    std::shared_ptr<State> state_;
 
 public:
-    explicit Reader(const std::string& filepath, bool skip_header = true)
-        : source_(filepath), current_(source_.data()), end_(current_ + source_.size()) {
-        if (skip_header && source_.valid()) {
-            parse_header();
-        }
+    CodecReducer(State init, Accumulate accumulate, Save save, Load load,
+                 std::shared_ptr<State> state)
+        : init_(std::move(init)),
+          accumulate_(std::move(accumulate)),
+          save_(std::move(save)),
+          load_(std::move(load)),
+          state_(std::move(state)) {}
+
+    void reset() override { *state_ = init_; }
+
+    void on_batch(std::span<const Row> rows) override {
+        for (const auto& row : rows)
+            accumulate_(*state_, row);
     }
 
-    // --- Header access ---
-    [[nodiscard]] std::string_view column_name(size_t idx) const noexcept {
-        return idx < Columns ? column_names_[idx] : std::string_view{};
+    void save(std::string& out) const override { save_(*state_, out); }
+
+    bool load(std::string_view in) override {
+        State loaded = init_;
+        if (!load_(loaded, in))
+            return false;
+        *state_ = std::move(loaded);
+        return true;
     }
+};
 
-    [[nodiscard]] std::optional<size_t> column_index(std::string_view name) const noexcept {
-        for (size_t i = 0; i < Columns; ++i) {
-            if (column_names_[i] == name)
-                return i;
+}  // namespace detail
+
+/// Reducers kept current over a file that only grows, such as a live trade
+/// log. Each refresh() parses just the bytes appended since the previous one
+/// and folds them into the reducer states, then persists the byte offset and
+/// every state to a checkpoint file, so a restarted process resumes where the
+/// last one stopped instead of rescanning.
+///
+/// A trailing line without its newline is left for the next refresh. The
+/// checkpoint remembers a hash of the bytes just before its offset; if the
+/// file was truncated or replaced, or the checkpoint does not match the
+/// registered reducers, the states are reset and the file is scanned from
+/// the start. Rows whose field count is not Columns are skipped.
+template <size_t Columns, char Delim = ',', typename NullPol = NullStandard>
+class IncrementalScan {
+public:
+    using Row = std::array<FieldRef, Columns>;
+
+    static constexpr size_t BATCH_ROWS = 256;
+    static constexpr size_t READ_BLOCK = 16 << 20;
+
+    IncrementalScan(std::string csv_path, std::string checkpoint_path, bool skip_header = true)
+        : csv_path_(std::move(csv_path)),
+          checkpoint_path_(std::move(checkpoint_path)),
+          skip_header_(skip_header) {}
+
+    /// Reducer over a trivially copyable state, persisted as raw bytes
+    /// Accumulate: void(State&, const std::array<FieldRef, Columns>&)
+    template <typename State, typename Accumulate>
+        requires std::is_trivially_copyable_v<State>
+    ScanResult<State> add_reducer(State init, Accumulate&& accumulate) {
+        return add_reducer(
+            std::move(init), std::forward<Accumulate>(accumulate),
+            [](const State& s, std::string& out) {
+                out.append(reinterpret_cast<const char*>(&s), sizeof(State));
+            },
+            [](State& s, std::string_view in) {
+                if (in.size() != sizeof(State))
+                    return false;
+                std::memcpy(&s, in.data(), sizeof(State));
+                return true;
+            });
+    }
+
+    /// Reducer with caller-defined persistence
+    /// Save: void(const State&, std::string& out) - append the encoded state
+    /// Load: bool(State&, std::string_view in) - false rejects the checkpoint
+    template <typename State, typename Accumulate, typename Save, typename Load>
+    ScanResult<State> add_reducer(State init, Accumulate&& accumulate, Save&& save, Load&& load) {
+        auto state = std::make_shared<State>(init);
+        reducers_.push_back(
+            std::make_unique<detail::CodecReducer<Columns, State, std::decay_t<Accumulate>,
+                                                  std::decay_t<Save>, std::decay_t<Load>>>(
+                std::move(init), std::forward<Accumulate>(accumulate), std::forward<Save>(save),
+                std::forward<Load>(load), state));
+        return ScanResult<State>(std::move(state));
+    }
+
+    /// Fold in the rows appended since the last refresh and checkpoint.
+    /// Returns the number of new rows.
+    std::expected<size_t, ErrorCode> refresh() {
+        if (!restored_) {
+            restore();
+            restored_ = true;
         }
-        return std::nullopt;
+
+        std::error_code ec;
+        const uint64_t file_size = std::filesystem::file_size(csv_path_, ec);
+        if (ec)
+            return std::unexpected(ErrorCode::FileOpenError);
+
+        // The bytes before offset_ must be unchanged, or this is a different file
+        uint64_t fingerprint = 0;
+        const bool replaced = file_size < offset_ || !fingerprint_at(offset_, fingerprint) ||
+                              fingerprint != fingerprint_;
+        if (replaced)
+            start_over();
+
+        const uint64_t start = offset_;
+        size_t new_rows = 0;
+        size_t block = READ_BLOCK;
+        while (offset_ < file_size) {
+            const size_t want = static_cast<size_t>(std::min<uint64_t>(block, file_size - offset_));
+            if (!detail::read_range(csv_path_, offset_, want, buffer_))
+                return std::unexpected(ErrorCode::FileOpenError);
+            const char* last_nl = last_newline(buffer_.data(), buffer_.size());
+            if (last_nl == nullptr) {
+                if (want < file_size - offset_ && buffer_.size() == want) {
+                    block *= 2;  // One line longer than a block
+                    continue;
+                }
+                break;  // Only an unterminated tail so far
+            }
+            const char* begin = buffer_.data();
+            const char* end = last_nl + 1;
+            if (offset_ == 0 && skip_header_)
+                begin += detail::find_newline(begin, end - begin) + 1;
+            new_rows += consume(begin, end);
+            offset_ += static_cast<uint64_t>(end - buffer_.data());
+            block = READ_BLOCK;
+        }
+        rows_ += new_rows;
+        if (offset_ == start && !replaced)
+            return new_rows;
+        if (!fingerprint_at(offset_, fingerprint_))
+            return std::unexpected(ErrorCode::FileOpenError);
+        if (!save())
+            return std::unexpected(ErrorCode::FileWriteError);
+        return new_rows;
     }
 
-    [[nodiscard]] const std::array<std::string_view, Columns>& headers() const noexcept {
-        return column_names_;
+    /// Bytes of the file folded into the states so far
+    [[nodiscard]] uint64_t offset() const noexcept { return offset_; }
+
+    /// Rows folded into the states so far, across restarts
+    [[nodiscard]] uint64_t rows() const noexcept { return rows_; }
+
+    [[nodiscard]] size_t reducer_count() const noexcept { return reducers_.size(); }
+
+private:
+    static constexpr char MAGIC[8] = {'B', 'Z', 'C', 'S', 'V', 'I', 'N', 'C'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t FINGERPRINT_BYTES = 64;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reducers;
+        uint64_t offset;
+        uint64_t rows;
+        uint64_t fingerprint;
+    };
+
+    static const char* last_newline(const char* data, size_t size) noexcept {
+        for (size_t i = size; i > 0; --i)
+            if (data[i - 1] == '\n')
+                return data + i - 1;
+        return nullptr;
     }
 
-    // --- Error access (only meaningful if ErrorPolicy::enabled) ---
-    [[nodiscard]] ErrorInfo last_error() const noexcept {
-        if constexpr (ErrorPolicy::enabled)
-            return last_error_;
-        return ErrorInfo{};
+    size_t consume(const char* begin, const char* end) {
+        std::vector<Row>& batch = batch_;
+        batch.clear();
+        size_t count = 0;
+        auto offer = [&] {
+            for (auto& reducer : reducers_)
+                reducer->on_batch(batch);
+            count += batch.size();
+            batch.clear();
+        };
+        ParallelReader<Columns, Delim, NullPol>::scan_lines(
+            begin, end, [&](const char** starts, const char** ends, size_t col) {
+                if (col != Columns)
+                    return;
+                Row& row = batch.emplace_back();
+                for (size_t i = 0; i < Columns; ++i)
+                    row[i] = FieldRef(starts[i], ends[i]);
+                if (batch.size() == BATCH_ROWS)
+                    offer();
+            });
+        if (!batch.empty())
+            offer();
+        return count;
     }
 
-    [[nodiscard]] bool has_error() const noexcept {
-        if constexpr (ErrorPolicy::enabled)
-            return !last_error_.ok();
-        return false;
+    /// Hash of the up to FINGERPRINT_BYTES bytes that end at `offset`
+    bool fingerprint_at(uint64_t offset, uint64_t& hash) {
+        const size_t bytes = static_cast<size_t>(std::min<uint64_t>(offset, FINGERPRINT_BYTES));
+        hash = 0;
+        if (bytes == 0)
+            return true;
+        if (!detail::read_range(csv_path_, offset - bytes, bytes, buffer_) ||
+            buffer_.size() != bytes)
+            return false;
+        hash = detail::stable_hash(buffer_);
+        return true;
     }
 
-    // ==========================================================================
-    // SIMD-ACCELERATED ITERATION
-    // ==========================================================================
+    void start_over() {
+        for (auto& reducer : reducers_)
+            reducer->reset();
+        offset_ = 0;
+        rows_ = 0;
+        fingerprint_ = 0;
+    }
 
-    /// Maximum performance - raw pointers with SIMD
-    /// Callback: void(const char** starts, const char** ends)
-    template <typename Callback>
-    BLAZECSV_HOT size_t for_each_raw(Callback&& callback) {
-        size_t count = 0;
-        std::array<const char*, Columns> starts;
-        std::array<const char*, Columns> ends;
+    /// Load the checkpoint if it fits the registered reducers
+    void restore() {
+        std::string data;
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(checkpoint_path_, ec);
+        if (ec || size < sizeof(Header) ||
+            !detail::read_range(checkpoint_path_, 0, static_cast<size_t>(size), data) ||
+            data.size() != size)
+            return;
+        Header header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+            header.reducers != reducers_.size())
+            return;
 
-        while (current_ < end_) {
-            // Dual-level prefetching
-            if (current_ + PREFETCH_L2 < end_) {
-                BLAZECSV_PREFETCH(current_ + PREFETCH_L1, 0, 3);  // L1, high temporal
-                BLAZECSV_PREFETCH(current_ + PREFETCH_L2, 0, 2);  // L2
+        size_t pos = sizeof(Header);
+        for (auto& reducer : reducers_) {
+            uint64_t length = 0;
+            if (data.size() - pos < sizeof(length))
+                return start_over();
+            std::memcpy(&length, data.data() + pos, sizeof(length));
+            pos += sizeof(length);
+            if (data.size() - pos < length ||
+                !reducer->load(std::string_view(data.data() + pos, length)))
+                return start_over();
+            pos += length;
+        }
+        offset_ = header.offset;
+        rows_ = header.rows;
+        fingerprint_ = header.fingerprint;
+    }
+
+    /// Write the checkpoint beside the target and rename it into place
+    bool save() {
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.reducers = static_cast<uint32_t>(reducers_.size());
+        header.offset = offset_;
+        header.rows = rows_;
+        header.fingerprint = fingerprint_;
+
+        std::string out(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::string encoded;
+        for (const auto& reducer : reducers_) {
+            encoded.clear();
+            reducer->save(encoded);
+            const uint64_t length = encoded.size();
+            out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            out += encoded;
+        }
+
+        const std::string tmp = checkpoint_path_ + ".tmp";
+        std::FILE* file = std::fopen(tmp.c_str(), "wb");
+        if (file == nullptr)
+            return false;
+        bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+        ok = (std::fclose(file) == 0) && ok;
+        std::error_code ec;
+        if (ok)
+            std::filesystem::rename(tmp, checkpoint_path_, ec);
+        return ok && !ec;
+    }
+
+    std::string csv_path_;
+    std::string checkpoint_path_;
+    bool skip_header_;
+    bool restored_ = false;
+    uint64_t offset_ = 0;
+    uint64_t rows_ = 0;
+    uint64_t fingerprint_ = 0;
+    std::string buffer_;
+    std::vector<Row> batch_;
+    std::vector<std::unique_ptr<detail::IncrementalReducer<Columns>>> reducers_;
+};
+
+// =============================================================================
+// GZIP INDEX - Checkpoints for parallel and random-access gzip decompression
+// =============================================================================
+
+#ifdef BLAZECSV_WITH_ZLIB
+
+/// zran-style access points into a .csv.gz file.
+///
+/// build() inflates the file once and, roughly every `span` uncompressed
+/// bytes, records a deflate block boundary: compressed offset, pending bit
+/// count and the preceding 32 KB window. Each checkpoint also stores the
+/// first line start at or after it and that line's number, so decompression
+/// can resume mid-file and land on a whole line. Segments between
+/// consecutive line starts decompress independently: in parallel, or to
+/// seek to a line. Multi-member files (concatenated gzip, BGZF) are supported.
+class GzipIndex {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DEFAULT_SPAN = 4 * 1024 * 1024;
+    static constexpr size_t WINDOW_SIZE = 32 * 1024;
+
+    /// Index gz_path into index_path; returns the number of checkpoints
+    static std::expected<size_t, ErrorCode> build(const std::string& gz_path,
+                                                  const std::string& index_path,
+                                                  size_t span = DEFAULT_SPAN) {
+        MmapSource gz(gz_path);
+        if (!gz.valid())
+            return std::unexpected(ErrorCode::FileOpenError);
+        const auto* const in = reinterpret_cast<const unsigned char*>(gz.data());
+        const size_t in_size = gz.size();
+
+        std::vector<Point> points;
+        std::vector<unsigned char> windows;
+        points.push_back(Point{});  // Start of file: gzip header, no window
+
+        z_stream z{};
+        if (inflateInit2(&z, 31) != Z_OK)
+            return std::unexpected(ErrorCode::DecompressError);
+
+        std::vector<unsigned char> win(WINDOW_SIZE);
+        uint64_t total_out = 0;
+        uint64_t newlines = 0;
+        uint64_t last = 0;
+        size_t pending = points.size();  // Points still waiting for a line start
+        bool failed = false;
+
+        z.next_in = const_cast<Bytef*>(in);
+        z.avail_out = 0;
+        while (true) {
+            if (z.avail_in == 0) {
+                const size_t pos = static_cast<size_t>(z.next_in - in);
+                if (pos >= in_size) {
+                    failed = true;  // Truncated stream
+                    break;
+                }
+                z.avail_in = static_cast<uInt>(std::min<size_t>(in_size - pos, 1u << 30));
+            }
+            if (z.avail_out == 0) {
+                z.next_out = win.data();
+                z.avail_out = static_cast<uInt>(WINDOW_SIZE);
             }
 
-            if constexpr (ErrorPolicy::track_line) {
-                ++line_number_;
+            unsigned char* produced_from = z.next_out;
+            const int ret = inflate(&z, Z_BLOCK);
+            if (ret != Z_OK && ret != Z_STREAM_END) {
+                failed = true;
+                break;
             }
 
-            // Skip empty lines
-            if (*current_ == '\n') {
-                ++current_;
-                continue;
+            // Track newlines to give checkpoints line-aligned starts
+            const auto* first = reinterpret_cast<const char*>(produced_from);
+            const auto* last_byte = reinterpret_cast<const char*>(z.next_out);
+            for (const char* p = first; p < last_byte;) {
+                const void* nl = std::memchr(p, '\n', last_byte - p);
+                if (nl == nullptr)
+                    break;
+                p = static_cast<const char*>(nl) + 1;
+                ++newlines;
+                for (; pending < points.size(); ++pending) {
+                    points[pending].line_offset = total_out + static_cast<uint64_t>(p - first);
+                    points[pending].line = newlines;
+                }
             }
-            if (*current_ == '\r') {
-                ++current_;
-                if (current_ < end_ && *current_ == '\n')
-                    ++current_;
+            total_out += static_cast<uint64_t>(last_byte - first);
+
+            if (ret == Z_STREAM_END) {
+                const size_t pos = static_cast<size_t>(z.next_in - in);
+                if (!member_follows(in, in_size, pos))
+                    break;
+                inflateReset(&z);
+                z.avail_in = static_cast<uInt>(std::min<size_t>(in_size - pos, 1u << 30));
                 continue;
             }
 
-            // Find line end using SIMD
-            size_t remaining = end_ - current_;
-            size_t line_len = detail::find_newline(current_, remaining);
-            const char* line_end = current_ + line_len;
-
-            // Strip CR if present
-            const char* effective_end = line_end;
-            if (effective_end > current_ && *(effective_end - 1) == '\r') {
-                --effective_end;
+            // Block boundary (or right after a member header), not in the last block
+            if ((z.data_type & 128) && !(z.data_type & 64) && total_out - last >= span) {
+                Point point{};
+                point.in = static_cast<uint64_t>(z.next_in - in);
+                point.out = total_out;
+                point.bits = static_cast<uint8_t>(z.data_type & 7);
+                point.window_size =
+                    static_cast<uint32_t>(std::min<uint64_t>(total_out, WINDOW_SIZE));
+                point.window_offset = windows.size();
+
+                // The window buffer is circular: oldest bytes start at next_out
+                const size_t head = static_cast<size_t>(z.next_out - win.data()) % WINDOW_SIZE;
+                if (total_out >= WINDOW_SIZE) {
+                    windows.insert(windows.end(), win.begin() + head, win.end());
+                    windows.insert(windows.end(), win.begin(), win.begin() + head);
+                } else {
+                    windows.insert(windows.end(), win.begin(), win.begin() + total_out);
+                }
+                points.push_back(point);
+                last = total_out;
             }
+        }
+        inflateEnd(&z);
+        if (failed)
+            return std::unexpected(ErrorCode::DecompressError);
 
-            // Parse fields using SIMD
-            const char* ptr = current_;
-            size_t col = 0;
+        for (; pending < points.size(); ++pending) {
+            points[pending].line_offset = total_out;
+            points[pending].line = newlines;
+        }
 
-            while (col < Columns && ptr < effective_end) {
-                starts[col] = ptr;
+        // Window offsets become absolute file offsets
+        const uint64_t windows_at = sizeof(Header) + points.size() * sizeof(Point);
+        for (auto& point : points)
+            point.window_offset += windows_at;
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.span = span;
+        header.gz_size = in_size;
+        header.total_out = total_out;
+        header.point_count = points.size();
+
+        std::FILE* out = std::fopen(index_path.c_str(), "wb");
+        if (out == nullptr)
+            return std::unexpected(ErrorCode::FileOpenError);
+        bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+                  std::fwrite(points.data(), sizeof(Point), points.size(), out) == points.size() &&
+                  (windows.empty() ||
+                   std::fwrite(windows.data(), 1, windows.size(), out) == windows.size());
+        ok = (std::fclose(out) == 0) && ok;
+        if (!ok)
+            return std::unexpected(ErrorCode::FileWriteError);
+        return points.size();
+    }
 
-                // SIMD field end detection
-                size_t field_len = detail::find_field_end(ptr, effective_end - ptr, Delim);
-                ptr += field_len;
-                ends[col] = ptr;
+    /// Map a .gz file and load its index
+    GzipIndex(const std::string& gz_path, const std::string& index_path)
+        : gz_(gz_path), index_(index_path) {
+        if (!gz_.valid() || !index_.valid() || index_.size() < sizeof(Header))
+            return;
+        const auto* header = reinterpret_cast<const Header*>(index_.data());
+        if (std::memcmp(header->magic, MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != VERSION || header->gz_size != gz_.size() ||
+            header->point_count == 0 ||
+            index_.size() < sizeof(Header) + header->point_count * sizeof(Point))
+            return;
+        const auto* points = reinterpret_cast<const Point*>(index_.data() + sizeof(Header));
+        for (size_t i = 0; i < header->point_count; ++i) {
+            if (points[i].window_offset + points[i].window_size > index_.size() ||
+                points[i].in > gz_.size())
+                return;
+        }
+        header_ = header;
+        points_ = points;
+    }
 
-                ++col;
+    /// Index present, well-formed and built for this file
+    [[nodiscard]] bool valid() const noexcept { return header_ != nullptr; }
 
-                // Skip delimiter
-                if (ptr < effective_end && *ptr == Delim) {
-                    ++ptr;
-                }
-            }
+    /// Uncompressed size
+    [[nodiscard]] uint64_t size() const noexcept { return valid() ? header_->total_out : 0; }
 
-            // Handle trailing empty field
-            bool trailing_empty = (col > 0 && col < Columns && ends[col - 1] < effective_end &&
-                                   *(ends[col - 1]) == Delim);
-            if (trailing_empty) {
-                starts[col] = ptr;
-                ends[col] = ptr;
-                ++col;
-            }
+    /// Independently decompressible, line-aligned ranges (some may be empty)
+    [[nodiscard]] size_t segment_count() const noexcept {
+        return valid() ? header_->point_count : 0;
+    }
 
-            // Advance to next line
-            current_ = (line_end < end_) ? line_end + 1 : end_;
+    /// Decompress segment i (whole lines) into out
+    bool read_segment(size_t i, std::string& out) const {
+        out.clear();
+        if (i >= segment_count())
+            return false;
+        const uint64_t begin = points_[i].line_offset;
+        const uint64_t end = segment_end(i);
+        if (begin >= end)
+            return true;
+        out.reserve(end - begin);
+        return inflate_from(points_[i], begin, [&](const char* data, size_t len) {
+            const size_t take = std::min<uint64_t>(len, end - begin - out.size());
+            out.append(data, take);
+            return out.size() < end - begin;
+        });
+    }
 
-            // Validate column count
-            if constexpr (ErrorPolicy::enabled) {
-                if (col != Columns) {
-                    last_error_ = ErrorInfo{ErrorCode::ColumnCountMismatch,
-                                            ErrorPolicy::track_line ? line_number_ : 0u,
-                                            static_cast<uint8_t>(col)};
+    /// Decompress segments on num_threads threads
+    /// Callback: void(size_t segment, std::string_view text), called concurrently;
+    /// text holds whole lines. Returns false if any segment failed to inflate.
+    template <typename Callback>
+    bool for_each_segment_parallel(Callback&& callback, size_t num_threads = 4) const {
+        std::atomic<size_t> next{0};
+        std::atomic<bool> ok{true};
+        auto worker = [&] {
+            std::string text;
+            for (size_t i = next++; i < segment_count(); i = next++) {
+                if (!read_segment(i, text)) {
+                    ok = false;
                     continue;
                 }
+                callback(i, std::string_view(text));
             }
+        };
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < std::max<size_t>(num_threads, 1); ++t)
+            threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads)
+            t.join();
+        return ok;
+    }
 
-            callback(starts.data(), ends.data());
-            ++count;
-        }
-
-        return count;
+    /// Parse rows from all segments in parallel, skipping the header line
+    /// Callback: void(const std::array<FieldRef, Columns>&), called concurrently
+    /// Returns the number of rows with exactly Columns fields
+    template <size_t Columns, char Delim = ',', typename Callback>
+    size_t for_each_row_parallel(Callback&& callback, size_t num_threads = 4,
+                                 bool skip_header = true) const {
+        std::atomic<size_t> rows{0};
+        for_each_segment_parallel(
+            [&](size_t segment, std::string_view text) {
+                const char* begin = text.data();
+                const char* end = begin + text.size();
+                if (segment == 0 && skip_header) {
+                    const size_t nl = detail::find_newline(begin, text.size());
+                    begin = nl < text.size() ? begin + nl + 1 : end;
+                }
+                size_t count = 0;
+                ParallelReader<Columns, Delim>::scan_lines(
+                    begin, end, [&](const char** starts, const char** ends, size_t col) {
+                        if (col != Columns)
+                            return;
+                        std::array<FieldRef, Columns> fields;
+                        for (size_t i = 0; i < Columns; ++i)
+                            fields[i] = FieldRef(starts[i], ends[i]);
+                        callback(fields);
+                        ++count;
+                    });
+                rows.fetch_add(count, std::memory_order_relaxed);
+            },
+            num_threads);
+        return rows.load();
     }
 
-    /// FieldRef-based iteration with SIMD parsing
-    /// Callback: void(const std::array<FieldRef, Columns>&)
+    /// Seek to 0-based physical line `first` (the header is line 0) and
+    /// deliver up to `count` lines, without their terminators
+    /// Callback: void(std::string_view line). Returns the number delivered.
     template <typename Callback>
-    BLAZECSV_HOT size_t for_each(Callback&& callback) {
-        return for_each_raw([&callback](const char** starts, const char** ends) {
-            std::array<FieldRef, Columns> fields;
-            // Unrolled for small column counts (compile-time)
-            for (size_t i = 0; i < Columns; ++i) {
-                fields[i] = FieldRef(starts[i], ends[i]);
+    size_t read_lines(uint64_t first, size_t count, Callback&& callback) const {
+        if (!valid() || count == 0)
+            return 0;
+        // Last checkpoint whose line start is at or before the target line
+        size_t k = 0;
+        for (size_t i = 1; i < header_->point_count && points_[i].line <= first; ++i) {
+            if (points_[i].line_offset < header_->total_out)
+                k = i;
+        }
+
+        uint64_t line = points_[k].line;
+        size_t delivered = 0;
+        std::string carry;
+        inflate_from(points_[k], points_[k].line_offset, [&](const char* data, size_t len) {
+            const char* p = data;
+            const char* end = data + len;
+            while (p < end) {
+                const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                if (line < first) {
+                    if (nl == nullptr)
+                        return true;
+                    ++line;
+                    p = nl + 1;
+                    continue;
+                }
+                if (nl == nullptr) {
+                    carry.append(p, end);
+                    return true;
+                }
+                carry.append(p, nl);
+                if (!carry.empty() && carry.back() == '\r')
+                    carry.pop_back();
+                callback(std::string_view(carry));
+                carry.clear();
+                ++line;
+                p = nl + 1;
+                if (++delivered == count)
+                    return false;
             }
-            callback(fields);
+            return true;
         });
+        if (!carry.empty() && delivered < count) {
+            if (carry.back() == '\r')
+                carry.pop_back();
+            callback(std::string_view(carry));
+            ++delivered;
+        }
+        return delivered;
     }
 
-    /// Process with early termination support
-    /// Callback: bool(const std::array<FieldRef, Columns>&) - return false to stop
-    template <typename Callback>
-    BLAZECSV_HOT size_t for_each_until(Callback&& callback) {
-        size_t count = 0;
-        std::array<const char*, Columns> starts;
-        std::array<const char*, Columns> ends;
+private:
+    static constexpr char MAGIC[8] = {'B', 'L', 'Z', 'G', 'Z', 'I', 'X', '\0'};
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t span;
+        uint64_t gz_size;
+        uint64_t total_out;
+        uint64_t point_count;
+        uint64_t padding[2];
+    };
+    static_assert(sizeof(Header) == 64);
+
+    struct Point {
+        uint64_t in = 0;           // Compressed offset of the first full byte
+        uint64_t out = 0;          // Uncompressed offset
+        uint64_t line_offset = 0;  // First line start at or after `out`
+        uint64_t line = 0;         // Number of that line
+        uint64_t window_offset = 0;
+        uint32_t window_size = 0;
+        uint8_t bits = 0;  // Bits of the byte before `in` still to decode
+        uint8_t reserved[3] = {};
+    };
+    static_assert(sizeof(Point) == 48);
+
+    MmapSource gz_;
+    MmapSource index_;
+    const Header* header_ = nullptr;
+    const Point* points_ = nullptr;
+
+    [[nodiscard]] static bool member_follows(const unsigned char* in, size_t size,
+                                             size_t pos) noexcept {
+        return pos + 2 <= size && in[pos] == 0x1f && in[pos + 1] == 0x8b;
+    }
 
-        while (current_ < end_) {
-            if (current_ + PREFETCH_L2 < end_) {
-                BLAZECSV_PREFETCH(current_ + PREFETCH_L1, 0, 3);
-                BLAZECSV_PREFETCH(current_ + PREFETCH_L2, 0, 2);
-            }
+    /// Line starts never decrease, so a segment ends where the next one starts
+    [[nodiscard]] uint64_t segment_end(size_t i) const noexcept {
+        return i + 1 < header_->point_count ? points_[i + 1].line_offset : header_->total_out;
+    }
 
-            if constexpr (ErrorPolicy::track_line) {
-                ++line_number_;
+    /// Inflate from a checkpoint, passing uncompressed bytes at or after
+    /// `from` to Sink: bool(const char* data, size_t len); false stops
+    template <typename Sink>
+    bool inflate_from(const Point& point, uint64_t from, Sink&& sink) const {
+        constexpr size_t CHUNK = 256 * 1024;
+        const auto* const in = reinterpret_cast<const unsigned char*>(gz_.data());
+        const size_t in_size = gz_.size();
+
+        z_stream z{};
+        const bool at_start = point.in == 0;
+        bool raw = !at_start;
+        if (inflateInit2(&z, raw ? -15 : 31) != Z_OK)
+            return false;
+        if (raw) {
+            if (point.bits != 0) {
+                const int byte = in[point.in - 1];
+                inflatePrime(&z, point.bits, byte >> (8 - point.bits));
             }
+            if (point.window_size != 0) {
+                inflateSetDictionary(
+                    &z, reinterpret_cast<const Bytef*>(index_.data() + point.window_offset),
+                    point.window_size);
+            }
+        }
 
-            if (*current_ == '\n') {
-                ++current_;
-                continue;
+        std::vector<char> buf(CHUNK);
+        uint64_t out_pos = point.out;
+        size_t pos = static_cast<size_t>(point.in);
+        bool ok = true;
+        z.next_in = const_cast<Bytef*>(in + pos);
+
+        while (true) {
+            if (z.avail_in == 0) {
+                pos = static_cast<size_t>(z.next_in - in);
+                if (pos >= in_size) {
+                    ok = false;  // Truncated
+                    break;
+                }
+                z.avail_in = static_cast<uInt>(std::min<size_t>(in_size - pos, 1u << 30));
             }
-            if (*current_ == '\r') {
-                ++current_;
-                if (current_ < end_ && *current_ == '\n')
-                    ++current_;
-                continue;
+            z.next_out = reinterpret_cast<Bytef*>(buf.data());
+            z.avail_out = static_cast<uInt>(CHUNK);
+            const int ret = inflate(&z, Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END) {
+                ok = false;
+                break;
             }
 
-            size_t remaining = end_ - current_;
-            size_t line_len = detail::find_newline(current_, remaining);
-            const char* line_end = current_ + line_len;
-            const char* effective_end = line_end;
-            if (effective_end > current_ && *(effective_end - 1) == '\r')
-                --effective_end;
-
-            const char* ptr = current_;
-            size_t col = 0;
-
-            while (col < Columns && ptr < effective_end) {
-                starts[col] = ptr;
-                size_t field_len = detail::find_field_end(ptr, effective_end - ptr, Delim);
-                ptr += field_len;
-                ends[col] = ptr;
-                ++col;
-                if (ptr < effective_end && *ptr == Delim)
-                    ++ptr;
+            const size_t produced = CHUNK - z.avail_out;
+            if (out_pos + produced > from) {
+                const size_t skip = out_pos < from ? static_cast<size_t>(from - out_pos) : 0;
+                if (!sink(buf.data() + skip, produced - skip))
+                    break;
+            }
+            out_pos += produced;
+
+            if (ret == Z_STREAM_END) {
+                pos = static_cast<size_t>(z.next_in - in) + (raw ? 8 : 0);  // Raw: skip trailer
+                if (!member_follows(in, in_size, pos))
+                    break;
+                if (raw) {
+                    inflateReset2(&z, 31);
+                    raw = false;
+                } else {
+                    inflateReset(&z);
+                }
+                z.next_in = const_cast<Bytef*>(in + pos);
+                z.avail_in = static_cast<uInt>(std::min<size_t>(in_size - pos, 1u << 30));
             }
+        }
+        inflateEnd(&z);
+        return ok;
+    }
+};
 
-            if (col > 0 && col < Columns && ends[col - 1] < effective_end &&
-                *(ends[col - 1]) == Delim) {
-                starts[col] = ptr;
-                ends[col] = ptr;
-                ++col;
-            }
+#endif  // BLAZECSV_WITH_ZLIB
 
-            current_ = (line_end < end_) ? line_end + 1 : end_;
+// =============================================================================
+// COLUMN CACHE - Parsed columns kept across queries under a memory budget
+// =============================================================================
 
-            if constexpr (ErrorPolicy::enabled) {
-                if (col != Columns)
-                    continue;
-            }
+/// One parsed column: a value per data row, plus whether it parsed
+/// (empty and malformed fields hold T{} and valid == 0)
+template <typename T>
+struct Column {
+    std::vector<T> values;
+    std::vector<uint8_t> valid;
+
+    [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+    /// Approximate heap footprint, charged against the cache budget
+    [[nodiscard]] size_t bytes() const noexcept {
+        size_t total = values.capacity() * sizeof(T) + valid.capacity();
+        if constexpr (std::is_same_v<T, std::string>) {
+            for (const auto& v : values)
+                total += v.capacity() > 15 ? v.capacity() : 0;  // Beyond the SSO buffer
+        }
+        return total;
+    }
+};
 
-            std::array<FieldRef, Columns> fields;
-            for (size_t i = 0; i < Columns; ++i) {
-                fields[i] = FieldRef(starts[i], ends[i]);
+/// LRU cache of typed columns for processes that query the same files repeatedly.
+///
+/// Entries are keyed by (path, column, type, delimiter) and stamped with the
+/// file's mtime and size; every get() re-stats the file and reparses when the
+/// stamp changed. Misses read just the requested column through WideReader,
+/// converting with FieldMemo so runs of repeated values are converted once.
+/// Least recently used entries are evicted to stay within the byte budget.
+/// Returned columns are shared, so eviction never invalidates a caller's copy.
+/// Thread-safe; parsing happens outside the lock.
+class ColumnCache {
+public:
+    explicit ColumnCache(size_t budget_bytes) : budget_(budget_bytes) {}
+
+    /// Column `column` (0-based, header skipped) of a delimited file parsed as T:
+    /// integers, floating point, bool, std::string, year_month_day or time_point
+    template <typename T, char Delim = ','>
+    std::expected<std::shared_ptr<const Column<T>>, ErrorCode> get(const std::string& path,
+                                                                   size_t column) {
+        static_assert(!std::is_same_v<T, std::string_view>,
+                      "views would outlive the file; cache std::string instead");
+
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        if (ec)
+            return std::unexpected(ErrorCode::FileOpenError);
+        const auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec)
+            return std::unexpected(ErrorCode::FileOpenError);
+        const Stamp stamp{static_cast<int64_t>(mtime.time_since_epoch().count()),
+                          static_cast<uint64_t>(size)};
+
+        std::string key = path;
+        key.push_back('\0');
+        key += std::to_string(column);
+        key.push_back('\0');
+        key += typeid(T).name();
+        key.push_back(Delim);
+
+        {
+            std::lock_guard lock(mutex_);
+            auto it = index_.find(key);
+            if (it != index_.end()) {
+                if (it->second->stamp == stamp) {
+                    lru_.splice(lru_.begin(), lru_, it->second);  // Most recently used
+                    ++hits_;
+                    return std::static_pointer_cast<const Column<T>>(it->second->column);
+                }
+                erase(it);  // File changed
             }
+            ++misses_;
+        }
 
-            ++count;
-            if (!callback(fields))
-                break;  // Early termination
+        auto loaded = load<T, Delim>(path, column);
+        if (!loaded)
+            return std::unexpected(loaded.error());  // Nothing cached for this stamp
+        auto parsed = std::make_shared<Column<T>>(std::move(*loaded));
+        const size_t bytes = parsed->bytes();
+
+        std::lock_guard lock(mutex_);
+        if (bytes <= budget_ && !index_.contains(key)) {
+            while (used_ + bytes > budget_ && !lru_.empty())
+                erase(index_.find(lru_.back().key));
+            lru_.push_front(Entry{key, stamp, parsed, bytes});
+            index_.emplace(std::move(key), lru_.begin());
+            used_ += bytes;
         }
+        return std::shared_ptr<const Column<T>>(std::move(parsed));
+    }
 
-        return count;
+    /// Drop every entry
+    void clear() {
+        std::lock_guard lock(mutex_);
+        lru_.clear();
+        index_.clear();
+        used_ = 0;
     }
 
-private:
-    void parse_header() {
-        if (current_ >= end_)
-            return;
+    [[nodiscard]] size_t budget() const noexcept { return budget_; }
 
-        if constexpr (ErrorPolicy::track_line) {
-            ++line_number_;
-        }
+    [[nodiscard]] size_t memory_used() const {
+        std::lock_guard lock(mutex_);
+        return used_;
+    }
 
-        // Find header line end using SIMD
-        size_t line_len = detail::find_newline(current_, end_ - current_);
-        const char* line_end = current_ + line_len;
-        const char* effective_end = line_end;
-        if (effective_end > current_ && *(effective_end - 1) == '\r')
-            --effective_end;
+    [[nodiscard]] size_t entries() const {
+        std::lock_guard lock(mutex_);
+        return lru_.size();
+    }
 
-        // Parse header fields
-        const char* ptr = current_;
-        size_t col = 0;
+    [[nodiscard]] size_t hits() const {
+        std::lock_guard lock(mutex_);
+        return hits_;
+    }
 
-        while (col < Columns && ptr < effective_end) {
-            const char* start = ptr;
-            size_t field_len = detail::find_field_end(ptr, effective_end - ptr, Delim);
-            ptr += field_len;
-            column_names_[col] = std::string_view(start, ptr - start);
-            ++col;
-            if (ptr < effective_end && *ptr == Delim)
-                ++ptr;
-        }
+    [[nodiscard]] size_t misses() const {
+        std::lock_guard lock(mutex_);
+        return misses_;
+    }
 
-        current_ = (line_end < end_) ? line_end + 1 : end_;
-        header_parsed_ = true;
+private:
+    struct Stamp {
+        int64_t mtime;
+        uint64_t size;
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    struct Entry {
+        std::string key;
+        Stamp stamp;
+        std::shared_ptr<const void> column;
+        size_t bytes;
+    };
+
+    using Index = std::unordered_map<std::string, std::list<Entry>::iterator>;
+
+    size_t budget_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;  // Front = most recently used
+    Index index_;
+    size_t used_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    void erase(Index::iterator it) {
+        used_ -= it->second->bytes;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    template <typename T, char Delim>
+    static std::expected<Column<T>, ErrorCode> load(const std::string& path, size_t column) {
+        FileSource source(path);
+        if (!source.opened())
+            return std::unexpected(ErrorCode::FileOpenError);  // Stat worked, open/read did not
+        Column<T> out;
+        WideReader<Delim> reader(std::move(source));
+        FieldMemo<T> memo;
+        const std::array<size_t, 1> selected{column};
+        reader.for_each_selected(selected, [&](std::span<const FieldRef> fields) {
+            if (fields[0].empty()) {
+                out.values.emplace_back();
+                out.valid.push_back(0);
+                return;
+            }
+            const auto& value = memo.parse(fields[0]);
+            out.values.push_back(value ? *value : T{});
+            out.valid.push_back(value ? 1 : 0);
+        });
+        out.values.shrink_to_fit();
+        out.valid.shrink_to_fit();
+        return out;
     }
 };
 
 // =============================================================================
-// PARALLEL READER - Multi-threaded SIMD processing
+// PARTITIONED OUTPUT - Split one CSV into per-key files in a single pass
 // =============================================================================
 
-template <size_t Columns, char Delim = ',', typename NullPol = NullStandard>
-class ParallelReader {
-    MmapSource source_;
-    const char* data_;
-    size_t size_;
-    size_t num_threads_;
+/// Tuning for partition_by
+struct PartitionOptions {
+    /// Output files held open at once (LRU)
+    size_t max_open_files = 256;
+    /// Append a partition once it buffers this much
+    size_t flush_bytes = 256 * 1024;
+    /// Per-worker cap on buffered bytes; flush all above
+    size_t worker_buffer_bytes = 32 << 20;
+    /// Start every file with the reader's header row
+    bool write_header = true;
+};
 
-    std::array<std::string_view, Columns> column_names_;
+/// What a partition_by run did
+struct PartitionStats {
+    /// Rows routed to a partition
+    size_t rows = 0;
+    /// Lines without the key column
+    size_t skipped = 0;
+    /// Distinct output files
+    size_t partitions = 0;
+    /// Bytes written, headers included
+    size_t bytes = 0;
+    /// fopen calls; more than `partitions` means LRU evictions
+    size_t opens = 0;
+};
 
-public:
-    explicit ParallelReader(const std::string& filepath, size_t num_threads = 4,
-                            bool skip_header = true)
-        : source_(filepath),
-          data_(source_.data()),
-          size_(source_.size()),
-          num_threads_(num_threads) {
-        if (skip_header && source_.valid()) {
-            // Skip header and capture names
-            size_t nl = detail::find_newline(data_, size_);
-            const char* line_end = data_ + nl;
-            const char* ptr = data_;
-            size_t col = 0;
-            while (col < Columns && ptr < line_end) {
-                const char* start = ptr;
-                size_t field_len = detail::find_field_end(ptr, line_end - ptr, Delim);
-                ptr += field_len;
-                column_names_[col++] = std::string_view(start, ptr - start);
-                if (ptr < line_end && *ptr == Delim)
-                    ++ptr;
-            }
-            data_ = (line_end < data_ + size_) ? line_end + 1 : data_ + size_;
-            size_ = (source_.data() + source_.size()) - data_;
-        }
-    }
+namespace detail {
 
-    [[nodiscard]] const std::array<std::string_view, Columns>& headers() const noexcept {
-        return column_names_;
+struct StringViewHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept {
+        return std::hash<std::string_view>{}(s);
     }
+};
 
-    /// Parallel iteration with SIMD
-    /// Note: Callback may be invoked from multiple threads!
-    template <typename Callback>
-    size_t for_each_parallel(Callback&& callback) {
-        if (size_ == 0)
-            return 0;
+/// Output files of one partition_by run behind a single lock. Callers only
+/// append large buffers, so the lock is held for few, long writes. At most
+/// `capacity` files stay open; the least recently appended one is closed to
+/// make room. A file is truncated and given the header the first time the
+/// run touches it, and reopened for append after an eviction.
+class PartitionSink {
+public:
+    PartitionSink(std::string_view pattern, std::string header, size_t capacity)
+        : pattern_(pattern), header_(std::move(header)), capacity_(std::max<size_t>(capacity, 1)) {}
 
-        // Find chunk boundaries (must be at newlines)
-        std::vector<std::pair<const char*, const char*>> chunks;
-        chunks.reserve(num_threads_);
+    PartitionSink(const PartitionSink&) = delete;
+    PartitionSink& operator=(const PartitionSink&) = delete;
 
-        size_t chunk_size = size_ / num_threads_;
-        const char* chunk_start = data_;
+    ~PartitionSink() { (void)close(); }
 
-        for (size_t i = 0; i < num_threads_ - 1 && chunk_start < data_ + size_; ++i) {
-            const char* approx_end = chunk_start + chunk_size;
-            if (approx_end >= data_ + size_) {
-                approx_end = data_ + size_;
-            } else {
-                // Find next newline
-                size_t remaining = (data_ + size_) - approx_end;
-                size_t nl = detail::find_newline(approx_end, remaining);
-                approx_end += nl;
-                if (approx_end < data_ + size_)
-                    ++approx_end;  // Skip the newline
-            }
+    [[nodiscard]] bool ok() const noexcept { return !failed_.load(std::memory_order_relaxed); }
 
-            chunks.emplace_back(chunk_start, approx_end);
-            chunk_start = approx_end;
+    /// Append `bytes` to key's file. False once any append has failed.
+    bool append(std::string_view key, std::string_view bytes) {
+        std::lock_guard lock(mutex_);
+        if (error_ != ErrorCode::Ok)
+            return false;
+        auto [it, created] = files_.try_emplace(path_for(key));
+        File& file = it->second;
+        if (file.handle == nullptr) {
+            if (open_.size() == capacity_) {
+                File* victim = open_.back();
+                open_.pop_back();
+                if (std::fclose(victim->handle) != 0)
+                    return fail(ErrorCode::FileWriteError);
+                victim->handle = nullptr;
+            }
+            file.handle = std::fopen(it->first.c_str(), created ? "wb" : "ab");
+            if (file.handle == nullptr)
+                return fail(ErrorCode::FileOpenError);
+            ++opens_;
+            open_.push_front(&file);
+            file.lru = open_.begin();
+            if (created && !write(file, header_))
+                return false;
+        } else {
+            open_.splice(open_.begin(), open_, file.lru);
         }
+        return write(file, bytes);
+    }
 
-        // Last chunk
-        if (chunk_start < data_ + size_) {
-            chunks.emplace_back(chunk_start, data_ + size_);
+    /// Close every open file; returns the first error of the run
+    std::expected<void, ErrorCode> close() {
+        std::lock_guard lock(mutex_);
+        for (File* file : open_) {
+            if (std::fclose(file->handle) != 0 && error_ == ErrorCode::Ok)
+                error_ = ErrorCode::FileWriteError;
+            file->handle = nullptr;
         }
+        open_.clear();
+        if (error_ != ErrorCode::Ok)
+            return std::unexpected(error_);
+        return {};
+    }
 
-        // Process chunks in parallel
-        std::vector<std::atomic<size_t>> counts(chunks.size());
-        std::vector<std::thread> threads;
-        threads.reserve(chunks.size());
+    [[nodiscard]] size_t partitions() const noexcept { return files_.size(); }
+    [[nodiscard]] size_t bytes() const noexcept { return bytes_; }
+    [[nodiscard]] size_t opens() const noexcept { return opens_; }
 
-        for (size_t i = 0; i < chunks.size(); ++i) {
-            threads.emplace_back([&, i]() {
-                counts[i].store(parse_chunk(chunks[i].first, chunks[i].second, callback));
-            });
+private:
+    struct File {
+        std::FILE* handle = nullptr;
+        std::list<File*>::iterator lru;
+    };
+
+    /// Substitute the key for "{}", percent-encoded so it stays one file name
+    /// in the pattern's directory and distinct keys never share a file: '%',
+    /// path separators and control bytes become %XX, "." and ".." are fully
+    /// encoded, and the empty key is a lone "%", which no other key produces
+    std::string path_for(std::string_view key) const {
+        static constexpr char HEX[] = "0123456789ABCDEF";
+        std::string name;
+        name.reserve(key.size());
+        const bool dots = key == "." || key == "..";
+        for (char c : key) {
+            const auto byte = static_cast<unsigned char>(c);
+            if (dots || c == '%' || c == '/' || c == '\\' || byte < 0x20 || byte == 0x7F) {
+                name += '%';
+                name += HEX[byte >> 4];
+                name += HEX[byte & 0xF];
+            } else {
+                name += c;
+            }
         }
+        if (key.empty())
+            name = "%";
+        std::string path = pattern_;
+        size_t slot = path.find("{}");
+        if (slot == std::string::npos)
+            return path + name;
+        return path.replace(slot, 2, name);
+    }
 
-        // Wait and sum
-        size_t total = 0;
-        for (size_t i = 0; i < threads.size(); ++i) {
-            threads[i].join();
-            total += counts[i].load();
-        }
+    bool write(File& file, std::string_view bytes) {
+        if (bytes.empty())
+            return true;
+        if (std::fwrite(bytes.data(), 1, bytes.size(), file.handle) != bytes.size())
+            return fail(ErrorCode::FileWriteError);
+        bytes_ += bytes.size();
+        return true;
+    }
 
-        return total;
+    bool fail(ErrorCode code) {
+        error_ = code;
+        failed_.store(true, std::memory_order_relaxed);
+        return false;
     }
 
-private:
-    template <typename Callback>
-    static size_t parse_chunk(const char* start, const char* end, Callback& callback) {
-        size_t count = 0;
-        const char* current = start;
+    std::string pattern_;
+    std::string header_;
+    size_t capacity_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, File> files_;  // By path; nodes are stable
+    std::list<File*> open_;                        // Most recently appended first
+    ErrorCode error_ = ErrorCode::Ok;
+    std::atomic<bool> failed_{false};
+    size_t bytes_ = 0;
+    size_t opens_ = 0;
+};
 
-        std::array<const char*, Columns> starts;
-        std::array<const char*, Columns> ends;
+}  // namespace detail
 
-        while (current < end) {
-            // Prefetch
-            if (current + 4096 < end) {
-                BLAZECSV_PREFETCH(current + 64, 0, 3);
-                BLAZECSV_PREFETCH(current + 4096, 0, 2);
-            }
+/// Split the reader's rows into one file per distinct value of `key_column`.
+/// `out_pattern` names the files, with "{}" standing for the key (appended
+/// if absent), e.g. "out/trades_{}.csv". Keys are percent-encoded where they
+/// contain '%', '/', '\' or control bytes or are "." or ".."; the empty
+/// key becomes "%". Every distinct key gets its own file.
+///
+/// Each chunk worker copies raw row bytes into per-key buffers and hands
+/// them to the shared sink in large appends, so the cost per row is a field
+/// scan and a memcpy whatever the partition count, and only
+/// `max_open_files` descriptors are held. Within a partition rows keep
+/// their order inside each chunk; with several threads, runs from different
+/// chunks may interleave. Use one thread for strict file order.
+template <size_t Columns, char Delim, typename NullPol>
+std::expected<PartitionStats, ErrorCode> partition_by(
+    ParallelReader<Columns, Delim, NullPol>& reader, size_t key_column,
+    std::string_view out_pattern, const PartitionOptions& options = {}) {
+    std::string header;
+    const auto& names = reader.headers();
+    if (options.write_header &&
+        std::any_of(names.begin(), names.end(), [](std::string_view n) { return !n.empty(); })) {
+        for (size_t i = 0; i < Columns; ++i) {
+            if (i > 0)
+                header += Delim;
+            header += names[i];
+        }
+        header += '\n';
+    }
 
-            if (*current == '\n') {
-                ++current;
-                continue;
+    detail::PartitionSink sink(out_pattern, std::move(header), options.max_open_files);
+    std::atomic<size_t> rows{0};
+    std::atomic<size_t> skipped{0};
+
+    reader.for_each_chunk([&](size_t, const char* begin, const char* end) {
+        std::unordered_map<std::string, std::string, detail::StringViewHash, std::equal_to<>>
+            buffers;
+        size_t buffered = 0;  // Capacity held by this worker's buffers
+        size_t chunk_rows = 0;
+        size_t chunk_skipped = 0;
+
+        auto flush_all = [&] {
+            for (auto& [key, buffer] : buffers) {
+                if (!buffer.empty())
+                    sink.append(key, buffer);
+                std::string().swap(buffer);  // Give the memory back
             }
-            if (*current == '\r') {
-                ++current;
-                if (current < end && *current == '\n')
-                    ++current;
+            buffered = 0;
+        };
+
+        for (const char* line = begin; line < end && sink.ok();) {
+            const char* line_end = line + detail::find_newline(line, end - line);
+            const char* next = line_end < end ? line_end + 1 : end;
+            const char* content_end = line_end;
+            if (content_end > line && *(content_end - 1) == '\r')
+                --content_end;
+            if (content_end == line) {
+                line = next;
                 continue;
             }
 
-            size_t line_len = detail::find_newline(current, end - current);
-            const char* line_end = current + line_len;
-            const char* effective_end = line_end;
-            if (effective_end > current && *(effective_end - 1) == '\r')
-                --effective_end;
-
-            const char* ptr = current;
+            // Locate the key field
+            const char* field = line;
+            const char* field_end = line + detail::find_field_end(line, content_end - line, Delim);
             size_t col = 0;
-
-            while (col < Columns && ptr < effective_end) {
-                starts[col] = ptr;
-                size_t field_len = detail::find_field_end(ptr, effective_end - ptr, Delim);
-                ptr += field_len;
-                ends[col] = ptr;
+            while (col < key_column && field_end < content_end) {
+                field = field_end + 1;
+                field_end = field + detail::find_field_end(field, content_end - field, Delim);
                 ++col;
-                if (ptr < effective_end && *ptr == Delim)
-                    ++ptr;
+            }
+            if (col != key_column) {
+                ++chunk_skipped;
+                line = next;
+                continue;
             }
 
-            if (col > 0 && col < Columns && ends[col - 1] < effective_end &&
-                *(ends[col - 1]) == Delim) {
-                starts[col] = ptr;
-                ends[col] = ptr;
-                ++col;
+            const std::string_view key(field, field_end - field);
+            auto it = buffers.find(key);
+            if (it == buffers.end())
+                it = buffers.try_emplace(std::string(key)).first;
+            std::string& buffer = it->second;
+            const size_t before = buffer.capacity();
+            buffer.append(line, next - line);
+            if (line_end == end)
+                buffer += '\n';  // Unterminated last line
+            buffered += buffer.capacity() - before;
+            ++chunk_rows;
+
+            if (buffer.size() >= options.flush_bytes) {
+                sink.append(key, buffer);
+                buffer.clear();
             }
+            if (buffered >= options.worker_buffer_bytes)
+                flush_all();
+            line = next;
+        }
+        flush_all();
+        rows.fetch_add(chunk_rows, std::memory_order_relaxed);
+        skipped.fetch_add(chunk_skipped, std::memory_order_relaxed);
+    });
+
+    if (auto closed = sink.close(); !closed)
+        return std::unexpected(closed.error());
+    return PartitionStats{rows.load(), skipped.load(), sink.partitions(), sink.bytes(),
+                          sink.opens()};
+}
 
-            current = (line_end < end) ? line_end + 1 : end;
+// =============================================================================
+// JSON OUTPUT - CSV to NDJSON / JSON array, parallel with ordered output
+// =============================================================================
 
-            if (col == Columns) {
-                std::array<FieldRef, Columns> fields;
-                for (size_t i = 0; i < Columns; ++i) {
-                    fields[i] = FieldRef(starts[i], ends[i]);
+/// Value type of a column in JSON output
+enum class JsonType : uint8_t {
+    /// Inferred from the first rows
+    Auto,
+    /// Always a JSON string
+    String,
+    /// Emitted verbatim; values that are not JSON numbers become strings
+    Number,
+    /// true/false in any case; other values become strings
+    Boolean,
+};
+
+/// Tuning for csv_to_ndjson
+struct JsonOptions {
+    /// Per column; columns beyond the list are Auto
+    std::vector<JsonType> types;
+    /// Worker threads converting morsels
+    size_t num_threads = 4;
+    /// One JSON array instead of one object per line
+    bool array = false;
+    /// Rows sampled for Auto columns
+    size_t infer_rows = 1000;
+    /// Input per work unit
+    size_t morsel_bytes = 1 << 20;
+};
+
+namespace detail {
+
+/// Offset of the first byte in [p, p + len) that JSON strings must escape:
+/// '"', '\\' or a control byte below 0x20. len if there is none.
+BLAZECSV_HOT inline size_t find_json_special(const char* p, size_t len) noexcept {
+    size_t i = 0;
+#if BLAZECSV_SIMD_NEON
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p + i));
+        uint8x16_t hit = vorrq_u8(vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+                                  vcltq_u8(chunk, space));
+        uint64_t nibbles =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        if (nibbles)
+            return i + static_cast<size_t>(std::countr_zero(nibbles)) / 4;
+    }
+#elif BLAZECSV_SIMD_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        // Unsigned x <= 0x1F exactly when max(x, 0x1F) == 0x1F
+        __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, control_max), control_max);
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), control);
+        if (int mask = _mm_movemask_epi8(hit))
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+    }
+#endif
+    for (; i < len; ++i) {
+        unsigned char c = static_cast<unsigned char>(p[i]);
+        if (c == '"' || c == '\\' || c < 0x20)
+            return i;
+    }
+    return len;
+}
+
+/// Append `s` as a quoted JSON string, copying clean runs wholesale
+inline void append_json_string(std::string& out, std::string_view s) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out += '"';
+    while (!s.empty()) {
+        size_t clean = find_json_special(s.data(), s.size());
+        out.append(s.data(), clean);
+        if (clean == s.size())
+            break;
+        const unsigned char c = static_cast<unsigned char>(s[clean]);
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                out += "\\u00";
+                out += HEX[c >> 4];
+                out += HEX[c & 0xF];
+        }
+        s.remove_prefix(clean + 1);
+    }
+    out += '"';
+}
+
+/// RFC 8259 number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+[[nodiscard]] inline bool is_json_number(std::string_view s) noexcept {
+    size_t i = 0;
+    auto digits = [&] {
+        size_t start = i;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9')
+            ++i;
+        return i > start;
+    };
+    if (i < s.size() && s[i] == '-')
+        ++i;
+    if (i < s.size() && s[i] == '0') {
+        ++i;
+    } else if (!digits()) {
+        return false;
+    }
+    if (i < s.size() && s[i] == '.') {
+        ++i;
+        if (!digits())
+            return false;
+    }
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        ++i;
+        if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+            ++i;
+        if (!digits())
+            return false;
+    }
+    return i == s.size();
+}
+
+/// "true" or "false" in any case; nullopt otherwise
+[[nodiscard]] inline std::optional<bool> json_bool(std::string_view s) noexcept {
+    auto equals = [s](std::string_view word) {
+        return s.size() == word.size() &&
+               std::equal(s.begin(), s.end(), word.begin(), [](char a, char b) {
+                   return (a | 0x20) == b;
+               });
+    };
+    if (equals("true"))
+        return true;
+    if (equals("false"))
+        return false;
+    return std::nullopt;
+}
+
+/// Fields of one line into `fields`; the line excludes its newline and CR
+template <char Delim>
+inline void split_line(const char* line, const char* end, std::vector<std::string_view>& fields) {
+    fields.clear();
+    for (const char* p = line;;) {
+        const char* field_end = p + find_field_end(p, end - p, Delim);
+        fields.emplace_back(p, field_end - p);
+        if (field_end >= end)
+            return;
+        p = field_end + 1;
+    }
+}
+
+}  // namespace detail
+
+/// Convert a CSV file to newline-delimited JSON (or a JSON array) using the
+/// header row's names as keys. Returns the number of objects written.
+///
+/// Column types come from `options.types`, else are inferred from the first
+/// `infer_rows` rows: Number if every non-empty value is a JSON number,
+/// Boolean if every one is true/false, String otherwise. Empty fields are
+/// null in Number and Boolean columns and "" in String columns. Rows whose
+/// field count differs from the header's are skipped; fields are taken
+/// verbatim, as the readers take them (no unquoting). Strings are escaped by
+/// a 16-byte scan for '"', '\\' and control bytes; bytes >= 0x80 are copied
+/// as they are, so the output is valid UTF-8 if the input is.
+///
+/// Threads convert 1 MB morsels into private buffers and append them to the
+/// output strictly in morsel order, so the output matches a serial run.
+template <char Delim = ','>
+std::expected<size_t, ErrorCode> csv_to_ndjson(const std::string& csv_path,
+                                               const std::string& out_path,
+                                               const JsonOptions& options = {}) {
+    FileSource source(csv_path);
+    if (!source.opened())
+        return std::unexpected(ErrorCode::FileOpenError);
+    const char* data = source.data();
+    const char* const end = data + source.size();
+
+    auto next_line = [end](const char* p, const char*& content_end) {
+        const char* line_end = p + detail::find_newline(p, end - p);
+        content_end = line_end;
+        if (content_end > p && content_end[-1] == '\r')
+            --content_end;
+        return line_end < end ? line_end + 1 : end;
+    };
+
+    // Keys, pre-rendered as "name":
+    std::vector<std::string_view> fields;
+    std::vector<std::string> keys;
+    const char* body = data;
+    if (data != nullptr && data < end) {
+        const char* header_end;
+        body = next_line(data, header_end);
+        detail::split_line<Delim>(data, header_end, fields);
+        for (std::string_view name : fields) {
+            std::string key;
+            detail::append_json_string(key, name);
+            key += ':';
+            keys.push_back(std::move(key));
+        }
+    }
+    const size_t columns = keys.size();
+
+    // Declared types, then inference for the rest
+    std::vector<JsonType> types(columns, JsonType::Auto);
+    for (size_t i = 0; i < columns && i < options.types.size(); ++i)
+        types[i] = options.types[i];
+    if (std::find(types.begin(), types.end(), JsonType::Auto) != types.end()) {
+        std::vector<uint8_t> number(columns, 1), boolean(columns, 1), seen(columns, 0);
+        size_t sampled = 0;
+        for (const char* p = body; p < end && sampled < options.infer_rows;) {
+            const char* content_end;
+            const char* next = next_line(p, content_end);
+            if (content_end > p) {
+                detail::split_line<Delim>(p, content_end, fields);
+                if (fields.size() == columns) {
+                    for (size_t i = 0; i < columns; ++i) {
+                        if (fields[i].empty())
+                            continue;
+                        seen[i] = 1;
+                        number[i] &= detail::is_json_number(fields[i]);
+                        boolean[i] &= detail::json_bool(fields[i]).has_value();
+                    }
+                    ++sampled;
                 }
-                callback(fields);
-                ++count;
             }
+            p = next;
+        }
+        for (size_t i = 0; i < columns; ++i) {
+            if (types[i] != JsonType::Auto)
+                continue;
+            types[i] = !seen[i]    ? JsonType::String
+                       : number[i] ? JsonType::Number
+                       : boolean[i] ? JsonType::Boolean
+                                    : JsonType::String;
         }
-
-        return count;
     }
-};
+
+    std::FILE* out = std::fopen(out_path.c_str(), "wb");
+    if (out == nullptr)
+        return std::unexpected(ErrorCode::FileOpenError);
+
+    auto convert = [&](const char* begin, const char* stop, std::string& buffer,
+                       std::vector<std::string_view>& row) {
+        size_t rows = 0;
+        for (const char* p = begin; p < stop;) {
+            const char* content_end;
+            const char* next = next_line(p, content_end);
+            if (content_end > p) {
+                detail::split_line<Delim>(p, content_end, row);
+                if (row.size() == columns) {
+                    if (options.array && rows > 0)
+                        buffer += ",\n";
+                    buffer += '{';
+                    for (size_t i = 0; i < columns; ++i) {
+                        if (i > 0)
+                            buffer += ',';
+                        buffer += keys[i];
+                        const std::string_view v = row[i];
+                        const JsonType type = types[i];
+                        if (v.empty() && type != JsonType::String) {
+                            buffer += "null";
+                        } else if (type == JsonType::Number && detail::is_json_number(v)) {
+                            buffer += v;
+                        } else if (auto b = detail::json_bool(v); type == JsonType::Boolean && b) {
+                            buffer += *b ? "true" : "false";
+                        } else {
+                            detail::append_json_string(buffer, v);
+                        }
+                    }
+                    buffer += '}';
+                    if (!options.array)
+                        buffer += '\n';
+                    ++rows;
+                }
+            }
+            p = next;
+        }
+        return rows;
+    };
+
+    // Morsels are claimed in order; each waits for its turn to write
+    const std::vector<const char*> bounds =
+        detail::morsel_bounds(body, end - body, std::max<size_t>(options.morsel_bytes, 1));
+    const size_t morsels = bounds.size() - 1;
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable turn;
+    size_t written = 0;      // Morsels written so far
+    size_t total_rows = 0;   // Guarded by mutex
+    bool failed = false;
+
+    auto worker = [&] {
+        std::string buffer;
+        std::vector<std::string_view> row;
+        for (size_t m; (m = next.fetch_add(1, std::memory_order_relaxed)) < morsels;) {
+            buffer.clear();
+            const size_t rows = convert(bounds[m], bounds[m + 1], buffer, row);
+            std::unique_lock lock(mutex);
+            turn.wait(lock, [&] { return written == m; });
+            if (!failed && rows > 0) {
+                if (total_rows > 0 && options.array)
+                    failed = std::fwrite(",\n", 1, 2, out) != 2;
+                failed = failed ||
+                         std::fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size();
+                total_rows += rows;
+            }
+            ++written;
+            turn.notify_all();
+        }
+    };
+
+    bool ok = !options.array || std::fputs("[\n", out) >= 0;
+    const size_t threads = std::clamp<size_t>(options.num_threads, 1, std::max<size_t>(morsels, 1));
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool)
+        thread.join();
+    ok = ok && !failed && (!options.array || std::fputs(total_rows ? "\n]\n" : "]\n", out) >= 0);
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok)
+        return std::unexpected(ErrorCode::FileWriteError);
+    return total_rows;
+}
 
 // =============================================================================
 // TYPE ALIASES - Convenient presets for common use cases
@@ -1244,6 +6621,12 @@ using TsvSafeReader = SafeReader<N, '\t'>;
 template <size_t N>
 using SafeTsvReader = SafeReader<N, '\t'>;
 
+/// Runtime column count (thousands of columns)
+using TsvWideReader = WideReader<'\t'>;
+
+/// Tab-separated output
+using TsvWriter = Writer<'\t'>;
+
 // =============================================================================
 // FACTORY FUNCTIONS
 // =============================================================================
@@ -0,0 +1,43 @@
+// Stand-in for systemtap's <sys/sdt.h> used by test_probes: instead of
+// emitting USDT notes, each probe records its name and arguments so the
+// probes-on build is compiled and checked where the real header is absent.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sdt_stub {
+
+struct Hit {
+    std::string name;
+    std::vector<uint64_t> args;
+};
+
+inline std::mutex mutex;
+inline std::vector<Hit> hits;
+
+template <typename T>
+uint64_t arg(T value) {
+    if constexpr (std::is_pointer_v<T>)
+        return reinterpret_cast<uintptr_t>(value);
+    else
+        return static_cast<uint64_t>(value);
+}
+
+inline void fire(const char* name, std::vector<uint64_t> args) {
+    std::lock_guard lock(mutex);
+    hits.push_back({name, std::move(args)});
+}
+
+}  // namespace sdt_stub
+
+#define DTRACE_PROBE2(provider, name, a, b) \
+    ::sdt_stub::fire(#provider ":" #name, {::sdt_stub::arg(a), ::sdt_stub::arg(b)})
+
+#define DTRACE_PROBE3(provider, name, a, b, c) \
+    ::sdt_stub::fire(#provider ":" #name,      \
+                     {::sdt_stub::arg(a), ::sdt_stub::arg(b), ::sdt_stub::arg(c)})
@@ -5,13 +5,17 @@
 
 #include <blazecsv/blazecsv.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <set>
 #include <thread>
+#include <vector>
 
 // Cross-platform temp file path
 inline std::string temp_path(const std::string& name) {
@@ -892,6 +896,664 @@ void test_fieldref_edge_cases() {
     }
 }
 
+// =============================================================================
+// WIDE READER (runtime column count)
+// =============================================================================
+
+void test_wide_reader() {
+    std::cout << "\n=== Wide Reader ===\n";
+
+    const std::string filename = temp_path("test_wide.csv");
+    constexpr size_t COLS = 10000;
+    constexpr size_t ROWS = 20;
+    {
+        std::ofstream f(filename);
+        for (size_t c = 0; c < COLS; ++c)
+            f << (c ? "," : "") << "c" << c;
+        f << "\n";
+        for (size_t r = 0; r < ROWS; ++r) {
+            for (size_t c = 0; c < COLS; ++c)
+                f << (c ? "," : "") << (r * COLS + c);
+            f << "\r\n";
+        }
+        f << "1,2,\n";  // Short row with trailing empty field
+    }
+
+    TEST("header with 10000 columns");
+    {
+        blazecsv::WideReader<> reader(filename);
+        if (reader.column_count() == COLS && reader.headers()[9999] == "c9999" &&
+            reader.column_index("c1234") == 1234u) {
+            PASS();
+        } else {
+            FAIL("got " << reader.column_count() << " columns");
+        }
+    }
+
+    TEST("full rows");
+    {
+        blazecsv::WideReader<> reader(filename);
+        bool ok = true;
+        size_t r = 0;
+        size_t rows = reader.for_each([&](const blazecsv::WideRow& row) {
+            if (r < ROWS) {
+                ok = ok && row.size() == COLS &&
+                     row[0].value_or<int64_t>(-1) == static_cast<int64_t>(r * COLS) &&
+                     row[COLS - 1].value_or<int64_t>(-1) ==
+                         static_cast<int64_t>(r * COLS + COLS - 1);
+            } else {
+                ok = ok && row.size() == 3 && row[2].empty() && row.at(5000).empty();
+            }
+            ++r;
+        });
+        if (ok && rows == ROWS + 1) {
+            PASS();
+        } else {
+            FAIL("row contents mismatch");
+        }
+    }
+
+    TEST("sparse column selection");
+    {
+        blazecsv::WideReader<> reader(filename);
+        const std::array<size_t, 3> cols{7000, 3, 42};
+        bool ok = true;
+        size_t r = 0;
+        reader.for_each_selected(cols, [&](std::span<const blazecsv::FieldRef> fields) {
+            if (r < ROWS) {
+                ok = ok && fields.size() == 3 &&
+                     fields[0].value_or<int64_t>(-1) == static_cast<int64_t>(r * COLS + 7000) &&
+                     fields[1].value_or<int64_t>(-1) == static_cast<int64_t>(r * COLS + 3) &&
+                     fields[2].value_or<int64_t>(-1) == static_cast<int64_t>(r * COLS + 42);
+            } else {
+                ok = ok && fields[0].empty() && fields[1].empty();
+            }
+            ++r;
+        });
+        if (ok && r == ROWS + 1) {
+            PASS();
+        } else {
+            FAIL("selected fields mismatch");
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// FIXED-LAYOUT ROWS (delimiter layout reuse)
+// =============================================================================
+
+// Reference split for comparison: one line, no terminator
+static std::vector<std::string> naive_split(const std::string& line, char delim, size_t max_cols) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (out.size() < max_cols) {
+        size_t pos = line.find(delim, start);
+        if (pos == std::string::npos) {
+            out.push_back(line.substr(start));
+            break;
+        }
+        out.push_back(line.substr(start, pos - start));
+        start = pos + 1;
+    }
+    return out;
+}
+
+void test_fixed_layout_rows() {
+    std::cout << "\n=== Fixed-Layout Rows ===\n";
+
+    const std::string filename = temp_path("test_fixed_layout.csv");
+    std::vector<std::string> lines;
+    for (int i = 0; i < 50; ++i)  // Identical layout
+        lines.push_back("2024-01-" + std::to_string(10 + i % 20) + ",101.25,AAPL,00" +
+                        std::to_string(100 + i));
+    lines.push_back("2024-01-10,1.25,MSFT,00100");   // Delimiter moves
+    lines.push_back("2024-01-10,1.25,MSFT,00101");   // Same as new layout
+    lines.push_back("2024-01-10,1.25,IBM,00101x");   // Same length, delimiter moved
+    lines.push_back("2024-01-10,1.25,IBM,00101x");
+    lines.push_back("2024-01-10,1.25,IBM,0,1,2,3");  // More fields than columns
+    lines.push_back("2024-01-10,1.25,IBM,9,9,9,9");
+    lines.push_back("2024-01-10,1.25,IBM,");         // Trailing empty field
+    lines.push_back("2024-01-11,1.25,IBM,");
+    for (int i = 0; i < 20; ++i)  // Long repeated rows (multiple 16-byte blocks)
+        lines.push_back("2024-01-10 09:30:00.000000," + std::to_string(1000 + i) +
+                        ".123456,ABCDEFGHIJKLMNOPQRSTUVWXYZ,xyz");
+
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << "date,price,symbol,id\n";
+        for (size_t i = 0; i < lines.size(); ++i)
+            f << lines[i] << (i % 7 == 3 ? "\r\n" : "\n");
+        f << "2024-01-10,1.25,IBM,00101";  // No trailing newline
+    }
+    lines.push_back("2024-01-10,1.25,IBM,00101");
+
+    std::vector<std::vector<std::string>> expected;
+    for (const auto& line : lines)
+        expected.push_back(naive_split(line, ',', 4));
+
+    TEST("for_each matches reference split");
+    {
+        blazecsv::TurboReader<4> reader(filename);
+        std::vector<std::vector<std::string>> got;
+        reader.for_each([&](const auto& fields) {
+            got.emplace_back();
+            for (const auto& field : fields)
+                got.back().emplace_back(field.view());
+        });
+        if (got == expected) {
+            PASS();
+        } else {
+            FAIL("rows differ from reference");
+        }
+    }
+
+    TEST("short rows rejected on layout change");
+    {
+        std::ofstream(filename, std::ios::binary) << "a,b,c\n1,2,3\n1,2,3\n1,2\n\n4,5,6\n4,5\n";
+        blazecsv::CheckedReader<3> reader(filename);
+        size_t rows = reader.for_each([](const auto&) {});
+        if (rows == 3 && reader.has_error()) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows);
+        }
+    }
+
+    TEST("parallel reader matches reference");
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << "a,b\n";
+        int64_t expected_sum = 0;
+        for (int i = 0; i < 20000; ++i) {
+            int v = (i % 3 == 0) ? 100 + i % 900 : 10 + i % 90;
+            expected_sum += v;
+            f << "x" << (i % 10) << "," << v << "\n";
+        }
+        f.close();
+        blazecsv::ParallelReader<2> reader(filename, 4);
+        std::atomic<int64_t> sum{0};
+        reader.for_each_parallel(
+            [&](const auto& fields) { sum.fetch_add(fields[1].template value_or<int64_t>(0)); });
+        if (sum == expected_sum) {
+            PASS();
+        } else {
+            FAIL("sum mismatch");
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// SPARSE ROWS (delimiter runs)
+// =============================================================================
+
+void test_sparse_rows() {
+    std::cout << "\n=== Sparse Rows ===\n";
+
+    // Mostly empty fields with the odd value, so delimiter runs cross 16-byte
+    // blocks at every alignment; some rows end in a delimiter
+    const std::string filename = temp_path("test_sparse.csv");
+    std::vector<std::string> lines;
+    uint32_t state = 12345;
+    auto next = [&state] { return state = state * 1664525u + 1013904223u, state >> 8; };
+    for (int i = 0; i < 2000; ++i) {
+        std::string line;
+        const size_t fields = 8 + next() % 60;
+        for (size_t c = 0; c < fields; ++c) {
+            if (c)
+                line += ',';
+            if (next() % 8 == 0)
+                line += std::string(1 + next() % 20, static_cast<char>('a' + c % 26));
+        }
+        if (line.find_first_not_of(',') == std::string::npos)
+            line.insert(line.begin(), '0');  // Keep rows distinguishable from blank lines
+        lines.push_back(line);
+    }
+
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << "h0,h1,h2,h3,h4,h5,h6,h7\n";
+        for (size_t i = 0; i < lines.size(); ++i)
+            f << lines[i] << (i % 5 == 2 ? "\r\n" : "\n");
+    }
+
+    TEST("reader matches reference split");
+    {
+        blazecsv::TurboReader<8> reader(filename);
+        std::vector<std::vector<std::string>> got;
+        reader.for_each([&](const auto& fields) {
+            got.emplace_back();
+            for (const auto& field : fields)
+                got.back().emplace_back(field.view());
+        });
+        std::vector<std::vector<std::string>> expected;
+        for (const auto& line : lines)
+            expected.push_back(naive_split(line, ',', 8));
+        if (got == expected) {
+            PASS();
+        } else {
+            FAIL("rows differ from reference");
+        }
+    }
+
+    TEST("wide reader matches reference split");
+    {
+        blazecsv::WideReader<> reader(filename);
+        bool ok = true;
+        size_t r = 0;
+        reader.for_each([&](const blazecsv::WideRow& row) {
+            std::vector<std::string> expected = naive_split(lines[r++], ',', SIZE_MAX);
+            ok = ok && row.size() == expected.size();
+            for (size_t c = 0; ok && c < row.size(); ++c)
+                ok = row[c].view() == expected[c];
+        });
+        if (ok && r == lines.size()) {
+            PASS();
+        } else {
+            FAIL("row " << r << " differs");
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// SHARED SCAN
+// =============================================================================
+
+void test_shared_scan() {
+    std::cout << "\n=== Shared Scan ===\n";
+
+    const std::string filename = temp_path("test_shared_scan.csv");
+    {
+        std::ofstream f(filename);
+        f << "symbol,qty,price\n";
+        for (int i = 0; i < 50000; ++i) {
+            f << (i % 3 == 0 ? "AAPL" : i % 3 == 1 ? "MSFT" : "GOOG") << "," << (i % 100) << ","
+              << (i % 7) << ".5\n";
+            if (i == 25000)
+                f << "bad,row\n";  // Skipped by every consumer
+        }
+    }
+
+    TEST("one parse feeds reducers and callbacks");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 4);
+        blazecsv::SharedScan<3> scan(reader);
+
+        auto qty = scan.add_reducer(
+            int64_t{0},
+            [](int64_t& s, const auto& row) { s += row[1].template value_or<int64_t>(0); },
+            [](int64_t& into, int64_t&& from) { into += from; });
+
+        using Counts = std::map<std::string, size_t>;
+        auto by_symbol = scan.add_reducer(
+            Counts{}, [](Counts& c, const auto& row) { ++c[std::string(row[0].view())]; },
+            [](Counts& into, Counts&& from) {
+                for (auto& [k, v] : from)
+                    into[k] += v;
+            });
+
+        // Merge order is file order: the first row seen is the file's first row
+        auto first = scan.add_reducer(
+            std::string{},
+            [](std::string& s, const auto& row) {
+                if (s.empty())
+                    s = std::string(row[2].view());
+            },
+            [](std::string& into, std::string&& from) {
+                if (into.empty())
+                    into = std::move(from);
+            });
+
+        std::atomic<size_t> seen{0};
+        scan.add([&](const auto&) { seen.fetch_add(1, std::memory_order_relaxed); });
+
+        size_t rows = scan.run();
+
+        int64_t expected_qty = 0;
+        for (int i = 0; i < 50000; ++i)
+            expected_qty += i % 100;
+
+        if (rows == 50000 && seen == 50000 && *qty == expected_qty && by_symbol->size() == 3 &&
+            by_symbol->at("AAPL") == 16667 && first.get() == "0.5" && scan.consumer_count() == 4) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " seen=" << seen.load() << " qty=" << *qty);
+        }
+    }
+
+    TEST("run twice gives the same result");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 3);
+        blazecsv::SharedScan<3> scan(reader);
+        auto count = scan.add_reducer(
+            size_t{0}, [](size_t& n, const auto&) { ++n; },
+            [](size_t& into, size_t&& from) { into += from; });
+        size_t a = scan.run();
+        size_t first_count = *count;
+        size_t b = scan.run();
+        if (a == 50000 && b == 50000 && first_count == 50000 && *count == 50000) {
+            PASS();
+        } else {
+            FAIL("a=" << a << " b=" << b << " count=" << *count);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// PARSE SCHEDULER
+// =============================================================================
+
+void test_parse_scheduler() {
+    std::cout << "\n=== Parse Scheduler ===\n";
+
+    TEST("every morsel runs once");
+    {
+        blazecsv::ParseScheduler scheduler(3);
+        std::vector<std::atomic<int>> hits(1000);
+        scheduler.run(1000, [&](size_t i) { hits[i].fetch_add(1); });
+        bool once = true;
+        for (auto& h : hits)
+            once = once && h.load() == 1;
+        if (once && scheduler.worker_count() == 3 && scheduler.queued_jobs() == 0) {
+            PASS();
+        } else {
+            FAIL("morsel ran zero or several times");
+        }
+    }
+
+    // One worker, held busy by a gate job until the jobs under test are queued
+    auto hold = [](blazecsv::ParseScheduler& scheduler, std::atomic<bool>& release) {
+        std::atomic<bool> started{false};
+        std::thread gate([&] {
+            scheduler.run(1, [&](size_t) {
+                started = true;
+                while (!release.load())
+                    std::this_thread::yield();
+            });
+        });
+        while (!started.load())
+            std::this_thread::yield();
+        return gate;
+    };
+
+    TEST("weights share the workers proportionally");
+    {
+        blazecsv::ParseScheduler scheduler(1);
+        std::atomic<bool> release{false};
+        std::thread gate = hold(scheduler, release);
+
+        std::mutex m;
+        std::string order;
+        auto job = [&](char tag, uint32_t weight) {
+            return std::thread([&, tag, weight] {
+                scheduler.run(
+                    40,
+                    [&](size_t) {
+                        std::lock_guard lock(m);
+                        order.push_back(tag);
+                    },
+                    blazecsv::Priority::Normal, weight);
+            });
+        };
+        std::thread heavy = job('H', 3);
+        std::thread light = job('L', 1);
+        while (scheduler.queued_jobs() != 2)
+            std::this_thread::yield();
+        release = true;
+        gate.join();
+        heavy.join();
+        light.join();
+
+        size_t heavy_first = std::count(order.begin(), order.begin() + 20, 'H');
+        if (order.size() == 80 && heavy_first >= 14 && heavy_first <= 16) {
+            PASS();
+        } else {
+            FAIL("order=" << order);
+        }
+    }
+
+    TEST("interactive jobs run ahead of batch jobs");
+    {
+        blazecsv::ParseScheduler scheduler(1);
+        std::atomic<bool> release{false};
+        std::thread gate = hold(scheduler, release);
+
+        std::mutex m;
+        std::string order;
+        auto job = [&](char tag, size_t morsels, blazecsv::Priority priority) {
+            return std::thread([&, tag, morsels, priority] {
+                scheduler.run(
+                    morsels,
+                    [&](size_t) {
+                        std::lock_guard lock(m);
+                        order.push_back(tag);
+                    },
+                    priority);
+            });
+        };
+        std::thread batch = job('B', 50, blazecsv::Priority::Batch);
+        while (scheduler.queued_jobs() != 1)
+            std::this_thread::yield();
+        std::thread small = job('I', 5, blazecsv::Priority::Interactive);
+        while (scheduler.queued_jobs() != 2)
+            std::this_thread::yield();
+        release = true;
+        gate.join();
+        batch.join();
+        small.join();
+
+        if (order.substr(0, 5) == "IIIII" && order.size() == 55) {
+            PASS();
+        } else {
+            FAIL("order=" << order);
+        }
+    }
+
+    TEST("ParallelReader on a shared scheduler");
+    {
+        const std::string filename = temp_path("test_scheduler.csv");
+        {
+            std::ofstream f(filename);
+            f << "a,b\n";
+            for (int i = 0; i < 30000; ++i)
+                f << i << "," << (i % 10) << "\n";
+        }
+        blazecsv::ParseScheduler scheduler(2);
+        blazecsv::ParallelReader<2> reader(filename, 16);  // 16 morsels, 2 workers
+        reader.use_scheduler(scheduler, blazecsv::Priority::Batch);
+        std::atomic<int64_t> sum{0};
+        size_t rows = reader.for_each_parallel(
+            [&](const auto& f) { sum.fetch_add(f[1].template value_or<int64_t>(0)); });
+        if (rows == 30000 && sum == 3000 * 45) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " sum=" << sum.load());
+        }
+        std::remove(filename.c_str());
+    }
+}
+
+// =============================================================================
+// KEY-AFFINE DISPATCH
+// =============================================================================
+
+void test_keyed_dispatch() {
+    std::cout << "\n=== Key-Affine Dispatch ===\n";
+
+    // Several morsels' worth of rows; seq counts up per symbol
+    const std::string filename = temp_path("test_keyed_dispatch.csv");
+    constexpr int SYMBOLS = 37;
+    constexpr int ROWS = 200000;
+    {
+        std::ofstream f(filename);
+        f << "symbol,seq,qty\n";
+        std::vector<int> seq(SYMBOLS, 0);
+        for (int i = 0; i < ROWS; ++i) {
+            int s = (i * 13 + i / 7) % SYMBOLS;
+            f << "SYM" << s << "," << seq[s]++ << "," << (i % 10) << "\n";
+            if (i == 1000)
+                f << "short,row\n";  // Skipped
+        }
+    }
+
+    TEST("every key on one consumer, in file order");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 4);
+        constexpr size_t CONSUMERS = 3;
+        // Only consumer c touches state[c]: no locks needed
+        struct State {
+            std::map<std::string, int64_t> next_seq;
+            std::thread::id thread;
+            bool ordered = true;
+            bool same_thread = true;
+        };
+        std::vector<State> state(CONSUMERS);
+        std::atomic<size_t> calls{0};
+
+        size_t rows = reader.for_each_by_key(0, CONSUMERS, [&](size_t c, const auto& row) {
+            State& st = state[c];
+            if (st.thread == std::thread::id{})
+                st.thread = std::this_thread::get_id();
+            st.same_thread = st.same_thread && st.thread == std::this_thread::get_id();
+            int64_t& expected = st.next_seq[std::string(row[0].view())];
+            st.ordered = st.ordered && row[1].template value_or<int64_t>(-1) == expected;
+            ++expected;
+            calls.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        size_t keys = 0;
+        bool ok = rows == ROWS && calls == ROWS;
+        for (const State& st : state) {
+            ok = ok && st.ordered && st.same_thread;
+            keys += st.next_seq.size();
+        }
+        if (ok && keys == SYMBOLS && reader.num_threads() == 4 &&
+            std::filesystem::file_size(filename) > 2 * decltype(reader)::KEYED_MORSEL_BYTES) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " keys=" << keys);
+        }
+    }
+
+    TEST("one consumer sees the whole file in order");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 3);
+        int64_t last = -1;
+        bool ordered = true;
+        size_t rows = reader.for_each_by_key(0, 1, [&](size_t, const auto& row) {
+            if (row[0].view() == "SYM0") {
+                int64_t seq = row[1].template value_or<int64_t>(-1);
+                ordered = ordered && seq == last + 1;
+                last = seq;
+            }
+        });
+        if (rows == ROWS && ordered && last > 0) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " last=" << last);
+        }
+    }
+
+    TEST("parse morsels run on an attached scheduler");
+    {
+        blazecsv::ParseScheduler scheduler(1);  // Fewer workers than ring slots in flight
+        blazecsv::ParallelReader<3> reader(filename, 4);
+        reader.use_scheduler(scheduler, blazecsv::Priority::Batch);
+        std::vector<std::map<std::string, int64_t>> next_seq(2);  // Per consumer
+        std::atomic<bool> ordered{true};
+        std::atomic<bool> queued{false};  // Job seen waiting on the pool mid-pass
+        size_t rows = reader.for_each_by_key(0, 2, [&](size_t c, const auto& row) {
+            int64_t& expected = next_seq[c][std::string(row[0].view())];
+            if (row[1].template value_or<int64_t>(-1) != expected)
+                ordered.store(false, std::memory_order_relaxed);
+            ++expected;
+            if (scheduler.queued_jobs() == 1)
+                queued.store(true, std::memory_order_relaxed);
+        });
+        if (rows == ROWS && ordered && queued && scheduler.queued_jobs() == 0) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " queued=" << queued.load());
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// BYTE-RANGE READER
+// =============================================================================
+
+void test_byte_ranges() {
+    std::cout << "\n=== Byte-Range Reader ===\n";
+
+    const std::string filename = temp_path("test_byte_ranges.csv");
+    std::vector<std::string> all;
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << "id,name\r\n";
+        for (int i = 0; i < 40; ++i) {
+            std::string name(static_cast<size_t>(i % 7), 'x');
+            f << i << "," << name << (i % 3 == 0 ? "\r\n" : "\n");
+            all.push_back(std::to_string(i) + "," + name);
+            if (i % 11 == 5)
+                f << "\n";  // Blank line
+        }
+        f << "40,last";  // No trailing newline
+        all.push_back("40,last");
+    }
+    const uint64_t size = std::filesystem::file_size(filename);
+
+    auto read_range = [&](uint64_t begin, uint64_t end, std::vector<std::string>& out) {
+        blazecsv::TurboReader<2> reader(filename, begin, end);
+        reader.for_each([&](const auto& f) {
+            out.push_back(std::string(f[0].view()) + "," + std::string(f[1].view()));
+        });
+        return reader.headers()[0] == "id" && reader.headers()[1] == "name";
+    };
+
+    TEST("every two-way split yields each row once");
+    {
+        bool ok = true;
+        for (uint64_t cut = 0; ok && cut <= size; ++cut) {
+            std::vector<std::string> rows;
+            ok = read_range(0, cut, rows) && read_range(cut, size, rows) && rows == all;
+        }
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("lost or duplicated rows");
+        }
+    }
+
+    TEST("many small ranges tile the file");
+    {
+        bool ok = true;
+        for (uint64_t step : {1u, 3u, 17u, 64u}) {
+            std::vector<std::string> rows;
+            for (uint64_t begin = 0; begin < size; begin += step)
+                ok = read_range(begin, begin + step, rows) && ok;
+            ok = ok && rows == all;
+        }
+        std::vector<std::string> past_end;
+        read_range(size, size + 100, past_end);
+        if (ok && past_end.empty()) {
+            PASS();
+        } else {
+            FAIL("ranges disagree with a full read");
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
 // =============================================================================
 // MAIN
 // =============================================================================
@@ -910,6 +1572,13 @@ int main() {
     test_parallel_reader_correctness();
     test_many_rows();
     test_fieldref_edge_cases();
+    test_wide_reader();
+    test_fixed_layout_rows();
+    test_sparse_rows();
+    test_shared_scan();
+    test_parse_scheduler();
+    test_keyed_dispatch();
+    test_byte_ranges();
 
     std::cout << "\n=== Summary ===\n";
     std::cout << "Tests run: " << tests_run << "\n";
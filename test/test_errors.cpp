@@ -450,6 +450,108 @@ void test_reader_types() {
     std::remove(filename.c_str());
 }
 
+void test_validation() {
+    std::cout << "\n=== Validation ===\n";
+
+    const std::string filename = temp_path("test_validation.csv");
+    {
+        std::ofstream f(filename);
+        f << "id,side,price,ts,venue\n";
+        f << "1,BUY,10.5,2024-01-02,XNAS\n";
+        f << "2,SELL,11.0,2024-01-03,XNYS\n";
+        f << "3,HOLD,abc,2024-01-01,\n";         // OneOf, Type, Monotonic, NotNull
+        f << "4,BUY,5000,2024-01-04,TOOLONG\n";  // Range, MaxLength
+        f << "2,BUY,1.0,2024-01-05,XNAS\n";      // Unique
+        f << "5,SELL,2.0\n";                     // ColumnCount
+        f << "6,SELL,2.0,2024-01-06,XNAS,extra\n";  // ColumnCount
+    }
+
+    blazecsv::Validator<5> validator;
+    validator.column(0).not_null().type(blazecsv::ColumnType::Integer).unique();
+    validator.column(1).one_of({"BUY", "SELL"});
+    validator.column(2).range(0.0, 1000.0);
+    validator.column(3).type(blazecsv::ColumnType::Date).monotonic();
+    validator.column(4).not_null().max_length(4);
+
+    TEST("violations reported with row numbers");
+    {
+        blazecsv::ParallelReader<5> reader(filename, 1);
+        auto report = validator.run(reader);
+        using blazecsv::Rule;
+        std::vector<std::pair<size_t, Rule>> got;
+        for (const auto& v : report.violations)
+            got.emplace_back(v.row, v.rule);
+        std::vector<std::pair<size_t, Rule>> expected = {
+            {3, Rule::OneOf},     {3, Rule::Type},        {3, Rule::Monotonic},
+            {3, Rule::NotNull},   {4, Rule::Range},       {4, Rule::MaxLength},
+            {5, Rule::Unique},    {6, Rule::ColumnCount}, {7, Rule::ColumnCount},
+        };
+        if (!report.ok() && report.rows == 7 && report.malformed_rows == 2 &&
+            report.violation_count == 9 && got == expected &&
+            report.count(2, Rule::Type) == 1 && report.violations[1].value == "abc" &&
+            report.violations[7].column == blazecsv::Violation::WHOLE_ROW &&
+            report.violations[7].value == "5,SELL,2.0") {
+            PASS();
+        } else {
+            FAIL("rows=" << report.rows << " violations=" << report.violation_count);
+        }
+    }
+
+    TEST("max_violations keeps the earliest");
+    {
+        blazecsv::ParallelReader<5> reader(filename, 1);
+        auto report = validator.run(reader, 2);
+        if (report.violations.size() == 2 && report.violation_count == 9 &&
+            report.violations[1].rule == blazecsv::Rule::Type) {
+            PASS();
+        } else {
+            FAIL("kept " << report.violations.size());
+        }
+    }
+
+    std::remove(filename.c_str());
+
+    // Large file: duplicates and order breaks land in different chunks
+    const std::string big = temp_path("test_validation_big.csv");
+    {
+        std::ofstream f(big);
+        f << "id,seq\n";
+        for (int i = 1; i <= 20000; ++i) {
+            int id = (i == 19000) ? 10 : i;    // Repeats row 10's id
+            int seq = (i == 12000) ? 5 : i;    // Goes backwards once
+            f << id << "," << seq << "\n";
+        }
+    }
+
+    TEST("cross-chunk unique and monotonic checks");
+    {
+        blazecsv::Validator<2> v;
+        v.column(0).unique();
+        v.column(1).type(blazecsv::ColumnType::Integer).monotonic(true);
+
+        blazecsv::ParallelReader<2> one(big, 1);
+        blazecsv::ParallelReader<2> four(big, 4);
+        auto a = v.run(one);
+        auto b = v.run(four);
+
+        bool same = a.violations.size() == b.violations.size();
+        for (size_t i = 0; same && i < a.violations.size(); ++i) {
+            same = a.violations[i].row == b.violations[i].row &&
+                   a.violations[i].rule == b.violations[i].rule;
+        }
+        // Only row 12000 breaks the order; row 12001 (12001 after 5) is fine
+        if (same && b.rows == 20000 && b.violation_count == 2 &&
+            b.count(0, blazecsv::Rule::Unique) == 1 && b.violations[0].row == 12000 &&
+            b.violations[1].row == 19000) {
+            PASS();
+        } else {
+            FAIL("one=" << a.violation_count << " four=" << b.violation_count);
+        }
+    }
+
+    std::remove(big.c_str());
+}
+
 int main() {
     std::cout << "=== BlazeCSV Error Handling Tests ===\n";
 
@@ -460,6 +562,7 @@ int main() {
     test_empty_file();
     test_as_optional();
     test_reader_types();
+    test_validation();
 
     std::cout << "\n=== Summary ===\n";
     std::cout << "Tests run: " << tests_run << "\n";
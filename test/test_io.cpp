@@ -0,0 +1,1534 @@
+// BlazeCSV - I/O Tests
+//
+// Tests for file sources: pooled read() fast path, mmap fallback, readers
+// constructed from explicit sources, and batched multi-file loading.
+
+#include <blazecsv/blazecsv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef BLAZECSV_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef BLAZECSV_WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef BLAZECSV_WITH_LZ4
+#include <lz4frame.h>
+#endif
+
+// Cross-platform temp file path
+inline std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+#define TEST(name)                       \
+    std::cout << "  " << name << "... "; \
+    tests_run++
+#define PASS()             \
+    std::cout << "PASS\n"; \
+    tests_passed++
+#define FAIL(msg) std::cout << "FAIL: " << msg << "\n"
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+static void write_rows(const std::string& filename, size_t rows) {
+    std::ofstream f(filename);
+    f << "id,value\n";
+    for (size_t i = 0; i < rows; ++i) {
+        f << i << "," << (i * 2) << "\n";
+    }
+}
+
+// =============================================================================
+// FILE SOURCE (read below threshold, mmap above)
+// =============================================================================
+
+void test_file_source() {
+    std::cout << "\n=== File Source ===\n";
+
+    const std::string filename = temp_path("test_io_source.csv");
+    write_rows(filename, 1000);
+
+    TEST("small file is read, not mapped");
+    {
+        blazecsv::FileSource src(filename);
+        if (src.valid() && !src.is_mapped() &&
+            src.size() == std::filesystem::file_size(filename)) {
+            PASS();
+        } else {
+            FAIL("expected pooled read source");
+        }
+    }
+
+    TEST("threshold 0 forces mmap");
+    {
+        blazecsv::FileSource src(filename, 0);
+        if (src.valid() && src.is_mapped()) {
+            PASS();
+        } else {
+            FAIL("expected mapped source");
+        }
+    }
+
+    TEST("read and mmap paths parse identically");
+    {
+        int64_t sum_read = 0;
+        int64_t sum_mmap = 0;
+        blazecsv::TurboReader<2> r1{blazecsv::FileSource(filename)};
+        blazecsv::TurboReader<2> r2{blazecsv::FileSource(filename, 0)};
+        size_t n1 =
+            r1.for_each([&](const auto& f) { sum_read += f[1].template value_or<int64_t>(0); });
+        size_t n2 =
+            r2.for_each([&](const auto& f) { sum_mmap += f[1].template value_or<int64_t>(0); });
+        if (n1 == 1000 && n2 == 1000 && sum_read == sum_mmap && r1.column_name(1) == "value") {
+            PASS();
+        } else {
+            FAIL("mismatch: " << n1 << " vs " << n2);
+        }
+    }
+
+    TEST("buffers are recycled by the thread pool");
+    {
+        const char* first = nullptr;
+        {
+            blazecsv::FileSource src(filename);
+            first = src.data();
+        }
+        blazecsv::FileSource again(filename);
+        if (again.data() == first) {
+            PASS();
+        } else {
+            FAIL("expected same pooled buffer");
+        }
+    }
+
+    TEST("source released on another thread");
+    {
+        blazecsv::FileSource src(filename);
+        std::thread t([s = std::move(src)]() mutable {
+            blazecsv::FileSource local = std::move(s);
+            (void)local;
+        });
+        t.join();
+        PASS();
+    }
+
+    TEST("missing file is invalid");
+    {
+        blazecsv::FileSource src(temp_path("does_not_exist_blazecsv.csv"));
+        blazecsv::TurboReader<2> reader(temp_path("does_not_exist_blazecsv.csv"));
+        if (!src.valid() && reader.for_each([](const auto&) {}) == 0) {
+            PASS();
+        } else {
+            FAIL("expected invalid source");
+        }
+    }
+
+    TEST("failed read is an open error, not a short file");
+    {
+        // A directory opens and has a nonzero size, but read() fails with EISDIR
+        const std::string dir = temp_path("test_io_read_error_dir");
+        std::filesystem::create_directory(dir);
+        blazecsv::FileSource src(dir);
+        blazecsv::CheckedReader<2> reader(dir);
+        blazecsv::CheckedReader<2> missing(temp_path("does_not_exist_blazecsv.csv"));
+        std::filesystem::remove(dir);
+        if (!src.valid() && !src.opened() && reader.for_each([](const auto&) {}) == 0 &&
+            reader.last_error().code == blazecsv::ErrorCode::FileOpenError &&
+            missing.last_error().code == blazecsv::ErrorCode::FileOpenError) {
+            PASS();
+        } else {
+            FAIL("opened=" << src.opened());
+        }
+    }
+
+    TEST("ParallelReader over read source");
+    {
+        blazecsv::ParallelReader<2> reader{blazecsv::FileSource(filename), 3};
+        std::atomic<size_t> rows{0};
+        reader.for_each_parallel([&](const auto&) { rows.fetch_add(1); });
+        if (rows == 1000) {
+            PASS();
+        } else {
+            FAIL("got " << rows.load());
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// MAPPED FILE CACHE
+// =============================================================================
+
+void test_mapped_file_cache() {
+    std::cout << "\n=== Mapped File Cache ===\n";
+
+    const std::string filename = temp_path("test_io_shared_map.csv");
+    write_rows(filename, 20000);
+    blazecsv::MappedFileCache cache;
+
+    TEST("readers share one mapping");
+    {
+        blazecsv::FileSource a = cache.open(filename);
+        blazecsv::TurboReader<2> reader{cache.open(filename)};
+        blazecsv::ParallelReader<2> parallel{cache.open(filename), 3};
+        size_t rows = reader.for_each([](const auto&) {});
+        std::atomic<size_t> prows{0};
+        parallel.for_each_parallel([&](const auto&) { prows.fetch_add(1); });
+        if (a.is_shared() && a.is_mapped() && rows == 20000 && prows == 20000 &&
+            cache.size() == 1 && cache.misses() == 1 && cache.hits() == 2) {
+            PASS();
+        } else {
+            FAIL("size=" << cache.size() << " hits=" << cache.hits() << " rows=" << rows);
+        }
+    }
+
+    TEST("same address while held, released when unused");
+    {
+        auto first = cache.acquire(filename);
+        auto second = cache.acquire(filename);
+        bool shared = first && first.get() == second.get();
+        first.reset();
+        second.reset();
+        if (shared && cache.size() == 0) {
+            PASS();
+        } else {
+            FAIL("size=" << cache.size());
+        }
+    }
+
+    TEST("modified file gets a fresh mapping");
+    {
+        auto before = cache.acquire(filename);
+        {
+            std::ofstream f(filename, std::ios::app);
+            f << "20000,40000\n";
+        }
+        auto after = cache.acquire(filename);
+        if (before && after && before.get() != after.get() && after->size() > before->size() &&
+            cache.size() == 2) {
+            PASS();
+        } else {
+            FAIL("expected a new mapping");
+        }
+    }
+
+    TEST("missing file and global cache");
+    {
+        blazecsv::FileSource missing = cache.open(temp_path("does_not_exist_blazecsv.csv"));
+        blazecsv::FileSource a = blazecsv::FileSource::shared(filename);
+        blazecsv::FileSource b = blazecsv::FileSource::shared(filename);
+        if (!missing.valid() && !missing.opened() && a.valid() && a.data() == b.data()) {
+            PASS();
+        } else {
+            FAIL("bad shared sources");
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// FILE BATCH SOURCE
+// =============================================================================
+
+void test_file_batch_source() {
+    std::cout << "\n=== File Batch Source ===\n";
+    std::cout << "  (io_uring " << (blazecsv::FileBatchSource::io_uring_available() ? "on" : "off")
+              << ")\n";
+
+    // 200 small files, one empty, one missing, one above the read threshold
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < 200; ++i) {
+        paths.push_back(temp_path("test_io_batch_" + std::to_string(i) + ".csv"));
+        write_rows(paths.back(), 10 + i % 7);
+    }
+    paths.push_back(temp_path("test_io_batch_empty.csv"));
+    std::ofstream(paths.back()).close();
+    paths.push_back(temp_path("test_io_batch_missing.csv"));
+    std::remove(paths.back().c_str());
+    paths.push_back(temp_path("test_io_batch_large.csv"));
+    write_rows(paths.back(), 5000);
+
+    size_t expected_rows = 5000;
+    for (size_t i = 0; i < 200; ++i)
+        expected_rows += 10 + i % 7;
+
+    auto count_rows = [](std::string_view contents) {
+        blazecsv::TurboReader<2> reader{blazecsv::FileSource::borrowed(contents)};
+        return reader.for_each([](const auto&) {});
+    };
+
+    TEST("sequential delivery in path order");
+    {
+        blazecsv::FileBatchSource batch(paths, 16, 4096);
+        std::vector<size_t> order;
+        size_t rows = 0;
+        size_t files = batch.for_each_file([&](size_t index, std::string_view contents) {
+            order.push_back(index);
+            rows += count_rows(contents);
+        });
+        bool in_order = order.size() == paths.size();
+        for (size_t i = 0; in_order && i < order.size(); ++i)
+            in_order = order[i] == i;
+        if (files == paths.size() && in_order && rows == expected_rows && batch.failed() == 1) {
+            PASS();
+        } else {
+            FAIL("files=" << files << " rows=" << rows << " failed=" << batch.failed());
+        }
+    }
+
+    TEST("parallel delivery parses every file once");
+    {
+        blazecsv::FileBatchSource batch(paths, 32, 4096);
+        std::atomic<size_t> rows{0};
+        std::vector<std::atomic<int>> seen(paths.size());
+        size_t files = batch.for_each_file_parallel(
+            [&](size_t index, std::string_view contents) {
+                seen[index].fetch_add(1);
+                rows.fetch_add(count_rows(contents));
+            },
+            3);
+        bool once = true;
+        for (auto& s : seen)
+            once = once && s.load() == 1;
+        if (files == paths.size() && once && rows == expected_rows) {
+            PASS();
+        } else {
+            FAIL("files=" << files << " rows=" << rows.load());
+        }
+    }
+
+#if BLAZECSV_HAS_IO_URING && defined(BLAZECSV_TESTING)
+    TEST("io_uring failure mid-pass falls back without leaks");
+    if (blazecsv::FileBatchSource::io_uring_available()) {
+        auto open_fds = [] {
+            return std::distance(std::filesystem::directory_iterator("/proc/self/fd"),
+                                 std::filesystem::directory_iterator{});
+        };
+        const auto fds_before = open_fds();
+        bool ok = true;
+        // Each batch enters twice (open+stat, then read+close): fail each in turn
+        for (int call = 0; call < 6 && ok; ++call) {
+            blazecsv::FileBatchSource batch(paths, 16, 4096);
+            blazecsv::detail::IoUring::inject_enter_failure = call;
+            size_t rows = 0, next = 0;
+            size_t files = batch.for_each_file([&](size_t index, std::string_view contents) {
+                ok = ok && index == next++;
+                rows += count_rows(contents);
+            });
+            ok = ok && files == paths.size() && rows == expected_rows && batch.failed() == 1;
+        }
+        blazecsv::detail::IoUring::inject_enter_failure = -1;
+        if (ok && open_fds() == fds_before) {
+            PASS();
+        } else {
+            FAIL("fds " << fds_before << " -> " << open_fds());
+        }
+    } else {
+        PASS();  // Nothing to inject into
+    }
+#endif
+
+    TEST("empty path list");
+    {
+        blazecsv::FileBatchSource batch({});
+        if (batch.for_each_file([](size_t, std::string_view) {}) == 0) {
+            PASS();
+        } else {
+            FAIL("expected no files");
+        }
+    }
+
+    for (const auto& p : paths)
+        std::remove(p.c_str());
+}
+
+// =============================================================================
+// WRITER (plain and block-compressed output)
+// =============================================================================
+
+static std::string slurp(const std::string& filename) {
+    std::ifstream f(filename, std::ios::binary);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+#ifdef BLAZECSV_WITH_ZLIB
+// Inflate a (multi-member) gzip stream
+static std::string gunzip(std::string_view in) {
+    std::string out;
+    z_stream zs{};
+    if (inflateInit2(&zs, 16 + MAX_WBITS) != Z_OK)
+        return out;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+    zs.avail_in = static_cast<uInt>(in.size());
+    char buf[65536];
+    while (true) {
+        zs.next_out = reinterpret_cast<Bytef*>(buf);
+        zs.avail_out = sizeof(buf);
+        int rc = inflate(&zs, Z_NO_FLUSH);
+        out.append(buf, sizeof(buf) - zs.avail_out);
+        if (rc == Z_STREAM_END) {
+            if (zs.avail_in == 0)
+                break;
+            inflateReset(&zs);
+        } else if (rc != Z_OK) {
+            break;
+        }
+    }
+    inflateEnd(&zs);
+    return out;
+}
+#endif
+
+#ifdef BLAZECSV_WITH_ZSTD
+// Decompress a stream of concatenated zstd frames
+static std::string unzstd(std::string_view in) {
+    std::string out;
+    ZSTD_DStream* ds = ZSTD_createDStream();
+    ZSTD_inBuffer input{in.data(), in.size(), 0};
+    char buf[65536];
+    while (input.pos < input.size) {
+        ZSTD_outBuffer output{buf, sizeof(buf), 0};
+        if (ZSTD_isError(ZSTD_decompressStream(ds, &output, &input)))
+            break;
+        out.append(buf, output.pos);
+    }
+    ZSTD_freeDStream(ds);
+    return out;
+}
+#endif
+
+#ifdef BLAZECSV_WITH_LZ4
+// Decompress a stream of concatenated LZ4 frames
+static std::string unlz4(std::string_view in) {
+    std::string out;
+    LZ4F_dctx* dctx = nullptr;
+    if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION)))
+        return out;
+    char buf[65536];
+    size_t pos = 0;
+    while (pos < in.size()) {
+        size_t out_size = sizeof(buf);
+        size_t in_size = in.size() - pos;
+        if (LZ4F_isError(LZ4F_decompress(dctx, buf, &out_size, in.data() + pos, &in_size,
+                                         nullptr)))
+            break;
+        out.append(buf, out_size);
+        pos += in_size;
+    }
+    LZ4F_freeDecompressionContext(dctx);
+    return out;
+}
+#endif
+
+void test_writer() {
+    std::cout << "\n=== Writer ===\n";
+
+    const std::string plain = temp_path("test_io_writer.csv");
+
+    auto write_all = [](blazecsv::Writer<>& w) {
+        w.write_row("id", "price", "symbol", "flag");
+        for (int i = 0; i < 100000; ++i) {
+            w.write_row(i, i * 0.25, std::string_view(i % 3 ? "AAPL" : "MSFT"), i % 2 == 0);
+        }
+    };
+
+    TEST("plain output round-trips through the reader");
+    {
+        blazecsv::Writer<> w(plain);
+        write_all(w);
+        auto closed = w.close();
+
+        blazecsv::TurboReader<4> reader(plain);
+        size_t rows = 0;
+        double sum = 0;
+        bool fields_ok = true;
+        reader.for_each([&](const auto& f) {
+            sum += f[1].value_or(0.0);
+            fields_ok = fields_ok && f[0].template value_or<int>(-1) == static_cast<int>(rows) &&
+                        f[3].view() == (rows % 2 == 0 ? "1" : "0");
+            ++rows;
+        });
+        if (closed && rows == 100000 && fields_ok && sum == 0.25 * (99999.0 * 100000 / 2)) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " sum=" << sum);
+        }
+    }
+
+    TEST("write_fields and raw write");
+    {
+        const std::string path = temp_path("test_io_writer_fields.csv");
+        {
+            blazecsv::TsvWriter w(path);
+            const std::array<std::string_view, 3> fields{"a", "", "c"};
+            w.write_fields(fields);
+            w.write("x\ty\tz\n");
+        }
+        if (slurp(path) == "a\t\tc\nx\ty\tz\n") {
+            PASS();
+        } else {
+            FAIL("got '" << slurp(path) << "'");
+        }
+        std::remove(path.c_str());
+    }
+
+    TEST("unavailable codec is reported");
+    {
+        blazecsv::Codec missing = blazecsv::Codec::None;
+        for (auto c : {blazecsv::Codec::Gzip, blazecsv::Codec::Zstd, blazecsv::Codec::Lz4}) {
+            if (!blazecsv::codec_available(c))
+                missing = c;
+        }
+        if (missing == blazecsv::Codec::None) {
+            PASS();  // Everything compiled in
+        } else {
+            blazecsv::Writer<> w(temp_path("test_io_writer_missing.csv"), missing);
+            w.write_row(1, 2);
+            auto closed = w.close();
+            if (!w.valid() && !closed && closed.error() == blazecsv::ErrorCode::CodecUnavailable) {
+                PASS();
+            } else {
+                FAIL("expected CodecUnavailable");
+            }
+        }
+    }
+
+    TEST("unwritable path");
+    {
+        blazecsv::Writer<> w(temp_path("no_such_dir_blazecsv/out.csv"));
+        auto closed = w.close();
+        if (!w.valid() && !closed && closed.error() == blazecsv::ErrorCode::FileOpenError) {
+            PASS();
+        } else {
+            FAIL("expected FileOpenError");
+        }
+    }
+
+#ifdef BLAZECSV_WITH_ZLIB
+    TEST("parallel BGZF output is valid gzip with row-aligned blocks");
+    {
+        const std::string gz = temp_path("test_io_writer.csv.gz");
+        {
+            blazecsv::Writer<> w(gz, blazecsv::Codec::Gzip, 3);
+            write_all(w);
+        }
+        const std::string expected = slurp(plain);
+        const std::string compressed = slurp(gz);
+
+        // Walk the blocks via their BSIZE fields; each must inflate on its own
+        size_t pos = 0;
+        size_t blocks = 0;
+        bool aligned = true;
+        while (pos + 18 <= compressed.size()) {
+            size_t bsize = static_cast<unsigned char>(compressed[pos + 16]) |
+                           (static_cast<unsigned char>(compressed[pos + 17]) << 8);
+            std::string block = gunzip(std::string_view(compressed).substr(pos, bsize + 1));
+            if (!block.empty() && block.back() != '\n')
+                aligned = false;
+            pos += bsize + 1;
+            ++blocks;
+        }
+
+        if (gunzip(compressed) == expected && pos == compressed.size() && blocks > 10 &&
+            aligned && compressed.size() < expected.size() / 2) {
+            PASS();
+        } else {
+            FAIL("blocks=" << blocks << " size=" << compressed.size());
+        }
+        std::remove(gz.c_str());
+    }
+
+    TEST("rows longer than a block are not cut");
+    {
+        const std::string gz = temp_path("test_io_writer_long.csv.gz");
+        std::string expected;
+        {
+            blazecsv::Writer<> w(gz, blazecsv::Codec::Gzip, 2, -1, 4096);
+            for (size_t i = 0; i < 60; ++i) {
+                std::string field((i * 7919) % 20000, static_cast<char>('a' + i % 26));
+                w.write_row(i, std::string_view(field));
+                expected += std::to_string(i) + "," + field + "\n";
+            }
+            std::string huge(100000, 'h');  // Over BGZF_MAX_INPUT: must span blocks
+            w.write_row(60, std::string_view(huge));
+            expected += "60," + huge + "\n";
+        }
+        const std::string compressed = slurp(gz);
+        size_t pos = 0;
+        size_t cut_rows = 0;
+        while (pos + 18 <= compressed.size()) {
+            size_t bsize = static_cast<unsigned char>(compressed[pos + 16]) |
+                           (static_cast<unsigned char>(compressed[pos + 17]) << 8);
+            std::string block = gunzip(std::string_view(compressed).substr(pos, bsize + 1));
+            if (!block.empty() && block.back() != '\n')
+                ++cut_rows;
+            pos += bsize + 1;
+        }
+        // Only the 100000-byte row may be split, and only at the BGZF limit
+        if (gunzip(compressed) == expected && cut_rows == 1) {
+            PASS();
+        } else {
+            FAIL("cut_rows=" << cut_rows);
+        }
+        std::remove(gz.c_str());
+    }
+#endif
+
+#if defined(BLAZECSV_WITH_ZSTD) || defined(BLAZECSV_WITH_LZ4)
+    auto check_frames = [&](blazecsv::Codec codec, const std::string& path, auto decompress) {
+        {
+            blazecsv::Writer<> w(path, codec, 3, -1, 64 * 1024);
+            write_all(w);
+        }
+        const std::string compressed = slurp(path);
+        std::remove(path.c_str());
+        return decompress(compressed) == slurp(plain) && compressed.size() < slurp(plain).size();
+    };
+#endif
+#ifdef BLAZECSV_WITH_ZSTD
+    TEST("parallel zstd output round-trips");
+    if (check_frames(blazecsv::Codec::Zstd, temp_path("test_io_writer.csv.zst"), unzstd)) {
+        PASS();
+    } else {
+        FAIL("zstd frames do not reproduce the input");
+    }
+#endif
+#ifdef BLAZECSV_WITH_LZ4
+    TEST("parallel LZ4 output round-trips");
+    if (check_frames(blazecsv::Codec::Lz4, temp_path("test_io_writer.csv.lz4"), unlz4)) {
+        PASS();
+    } else {
+        FAIL("LZ4 frames do not reproduce the input");
+    }
+#endif
+
+    std::remove(plain.c_str());
+}
+
+// =============================================================================
+// HASH INDEX SIDECAR
+// =============================================================================
+
+void test_hash_index() {
+    std::cout << "\n=== Hash Index ===\n";
+
+    const std::string csv = temp_path("test_io_index.csv");
+    const std::string idx = temp_path("test_io_index.csv.idx");
+    {
+        std::ofstream f(csv);
+        f << "order_id,qty\r\n";
+        for (int i = 0; i < 20000; ++i)
+            f << "ORD" << i << "," << i << "\r\n";
+        f << "ORD77,dup\r\n";  // Duplicate key
+        f << "\r\n";
+        f << "short\n";     // No column 1
+    }
+
+    TEST("build indexes every row");
+    {
+        auto built = blazecsv::HashIndex<>::build(csv, 0, idx);
+        if (built && *built == 20002) {
+            PASS();
+        } else {
+            FAIL("built=" << (built ? *built : 0));
+        }
+    }
+
+    TEST("lookup verifies keys and returns all rows");
+    {
+        blazecsv::HashIndex<> index(csv, idx);
+        auto hit = index.lookup("ORD12345");
+        auto dup = index.lookup("ORD77");
+        auto miss = index.lookup("ORD20000");
+        auto prefix = index.lookup("ORD1234");
+        uint64_t offset = 0;
+        index.for_each_match("ORD0", [&](uint64_t off, std::string_view) { offset = off; });
+        if (index.valid() && index.size() == 20002 && hit.size() == 1 &&
+            hit[0] == "ORD12345,12345" && dup.size() == 2 && miss.empty() &&
+            prefix.size() == 1 && prefix[0] == "ORD1234,1234" && offset == 14 &&
+            index.lookup("short").size() == 1 && index.lookup("order_id").empty()) {
+            PASS();
+        } else {
+            FAIL("hit=" << hit.size() << " dup=" << dup.size() << " offset=" << offset);
+        }
+    }
+
+    TEST("lookup by a non-first column");
+    {
+        blazecsv::HashIndex<>::build(csv, 1, idx).value();
+        blazecsv::HashIndex<> index(csv, idx);
+        auto rows = index.lookup("dup");
+        if (index.key_column() == 1 && rows.size() == 1 && rows[0] == "ORD77,dup" &&
+            index.size() == 20001) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows.size() << " size=" << index.size());
+        }
+    }
+
+    TEST("stale index is rejected");
+    {
+        std::ofstream(csv, std::ios::app) << "ORD99999,1\n";
+        blazecsv::HashIndex<> index(csv, idx);
+        if (!index.valid() && index.lookup("ORD1").empty()) {
+            PASS();
+        } else {
+            FAIL("expected invalid index");
+        }
+    }
+
+    TEST("same-size rewrite is stale");
+    {
+        std::ofstream(csv, std::ios::binary) << "k,v\nA,1\nB,2\n";
+        blazecsv::HashIndex<>::build(csv, 0, idx).value();
+        const auto built_at = std::filesystem::last_write_time(csv);
+        std::ofstream(csv, std::ios::binary) << "k,v\nA,1\nC,3\n";
+        blazecsv::HashIndex<> rewritten(csv, idx);
+        // Same size and the old mtime: the content hash still catches it
+        std::filesystem::last_write_time(csv, built_at);
+        blazecsv::HashIndex<> touched_back(csv, idx);
+        if (!rewritten.valid() && !touched_back.valid()) {
+            PASS();
+        } else {
+            FAIL("stale index accepted");
+        }
+    }
+
+    TEST("index without a free slot");
+    {
+        std::ofstream(csv, std::ios::binary) << "k,v\nA,1\nB,2\n";
+        blazecsv::HashIndex<>::build(csv, 0, idx).value();
+        std::string bytes = slurp(idx);
+        uint64_t slot_count;
+        std::memcpy(&slot_count, bytes.data() + 24, 8);
+        // Every slot taken: rejected by its entry count...
+        const uint64_t taken = 1;
+        for (uint64_t i = 0; i < slot_count; ++i)
+            std::memcpy(bytes.data() + 64 + i * 16 + 8, &taken, 8);
+        std::memcpy(bytes.data() + 32, &slot_count, 8);
+        std::ofstream(idx, std::ios::binary) << bytes;
+        blazecsv::HashIndex<> full(csv, idx);
+        // ...and a lying entry count still cannot make lookups spin
+        const uint64_t claimed = 2;
+        std::memcpy(bytes.data() + 32, &claimed, 8);
+        std::ofstream(idx, std::ios::binary) << bytes;
+        blazecsv::HashIndex<> lying(csv, idx);
+        if (!full.valid() && lying.valid() && lying.lookup("A").empty()) {
+            PASS();
+        } else {
+            FAIL("full=" << full.valid() << " lying=" << lying.valid());
+        }
+    }
+
+    TEST("missing CSV");
+    {
+        auto built = blazecsv::HashIndex<>::build(temp_path("no_such_blazecsv.csv"), 0, idx);
+        if (!built && built.error() == blazecsv::ErrorCode::FileOpenError) {
+            PASS();
+        } else {
+            FAIL("expected FileOpenError");
+        }
+    }
+
+    std::remove(csv.c_str());
+    std::remove(idx.c_str());
+}
+
+#ifdef BLAZECSV_WITH_ZLIB
+// =============================================================================
+// GZIP CHECKPOINT INDEX
+// =============================================================================
+
+void test_gzip_index() {
+    std::cout << "\n=== Gzip Index ===\n";
+
+    // Same rows as a single-member gzip file and as multi-member BGZF
+    std::string text = "id,value,label\n";
+    for (int i = 0; i < 200000; ++i)
+        text += std::to_string(i) + "," + std::to_string(i % 1000) + ",row" +
+                std::to_string(i % 13) + "\n";
+    int64_t expected_sum = 0;
+    for (int i = 0; i < 200000; ++i)
+        expected_sum += i % 1000;
+
+    const std::string single = temp_path("test_io_single.csv.gz");
+    {
+        gzFile f = gzopen(single.c_str(), "wb6");
+        gzwrite(f, text.data(), static_cast<unsigned>(text.size()));
+        gzclose(f);
+    }
+    const std::string bgzf = temp_path("test_io_bgzf.csv.gz");
+    {
+        blazecsv::Writer<> w(bgzf, blazecsv::Codec::Gzip, 2);
+        w.write(text);
+    }
+    const std::string idx = temp_path("test_io_gz.idx");
+
+    for (const auto& gz : {single, bgzf}) {
+        const bool is_bgzf = gz == bgzf;
+        std::string tag = is_bgzf ? " (BGZF)" : " (single member)";
+
+        TEST("build checkpoints" + tag);
+        auto built = blazecsv::GzipIndex::build(gz, idx, 256 * 1024);
+        if (built && *built > 4) {
+            PASS();
+        } else {
+            FAIL("points=" << (built ? *built : 0));
+        }
+
+        blazecsv::GzipIndex index(gz, idx);
+
+        TEST("segments reassemble the file" + tag);
+        {
+            std::vector<std::string> parts(index.segment_count());
+            bool ok = index.for_each_segment_parallel(
+                [&](size_t i, std::string_view seg) { parts[i] = std::string(seg); }, 3);
+            std::string joined;
+            bool aligned = true;
+            for (const auto& part : parts) {
+                aligned = aligned && (part.empty() || part.back() == '\n');
+                joined += part;
+            }
+            if (ok && index.valid() && index.size() == text.size() && joined == text && aligned) {
+                PASS();
+            } else {
+                FAIL("segments=" << parts.size() << " size=" << joined.size());
+            }
+        }
+
+        TEST("parallel row parsing" + tag);
+        {
+            std::atomic<int64_t> sum{0};
+            size_t rows = index.for_each_row_parallel<3>(
+                [&](const auto& f) { sum.fetch_add(f[1].template value_or<int64_t>(0)); }, 4);
+            if (rows == 200000 && sum == expected_sum) {
+                PASS();
+            } else {
+                FAIL("rows=" << rows << " sum=" << sum.load());
+            }
+        }
+
+        TEST("seek to a line" + tag);
+        {
+            std::vector<std::string> lines;
+            size_t n = index.read_lines(150001, 3, [&](std::string_view line) {
+                lines.emplace_back(line);
+            });
+            std::vector<std::string> tail;
+            index.read_lines(199999, 10, [&](std::string_view line) { tail.emplace_back(line); });
+            if (n == 3 && lines[0] == "150000,0,row6" && lines[2] == "150002,2,row8" &&
+                tail.size() == 2 && tail[1] == "199999,999,row7") {
+                PASS();
+            } else {
+                FAIL("n=" << n << " first=" << (lines.empty() ? "" : lines[0]));
+            }
+        }
+    }
+
+    TEST("stale or corrupt input is rejected");
+    {
+        blazecsv::GzipIndex::build(single, idx, 256 * 1024).value();
+        blazecsv::GzipIndex mismatched(bgzf, idx);
+        const std::string plain = temp_path("test_io_not_gzip.csv");
+        std::ofstream(plain) << "not,gzip\n";
+        auto bad = blazecsv::GzipIndex::build(plain, idx);
+        if (!mismatched.valid() && !bad && bad.error() == blazecsv::ErrorCode::DecompressError) {
+            PASS();
+        } else {
+            FAIL("expected rejection");
+        }
+        std::remove(plain.c_str());
+    }
+
+    std::remove(single.c_str());
+    std::remove(bgzf.c_str());
+    std::remove(idx.c_str());
+}
+#endif
+
+// =============================================================================
+// COLUMN CACHE
+// =============================================================================
+
+void test_column_cache() {
+    std::cout << "\n=== Column Cache ===\n";
+
+    const std::string a = temp_path("test_io_cache_a.csv");
+    const std::string b = temp_path("test_io_cache_b.csv");
+    auto write = [](const std::string& path, int rows, int scale) {
+        std::ofstream f(path);
+        f << "date,price,symbol\n";
+        for (int i = 0; i < rows; ++i)
+            f << "2024-01-0" << (1 + i / 1000) << "," << (i * scale) << ".5,S" << (i % 4)
+              << "\n";
+        f << "2024-01-09,,S0\n";  // Empty price
+    };
+    write(a, 5000, 1);
+    write(b, 5000, 2);
+
+    blazecsv::ColumnCache cache(1 << 20);
+
+    TEST("miss parses, hit reuses");
+    {
+        auto first = cache.get<double>(a, 1);
+        auto second = cache.get<double>(a, 1);
+        if (first && second && first->get() == second->get() && (*first)->size() == 5001 &&
+            (*first)->values[10] == 10.5 && (*first)->valid[5000] == 0 && cache.hits() == 1 &&
+            cache.misses() == 1 && cache.memory_used() == (*first)->bytes()) {
+            PASS();
+        } else {
+            FAIL("hits=" << cache.hits() << " misses=" << cache.misses());
+        }
+    }
+
+    TEST("type and column are part of the key");
+    {
+        auto dates = cache.get<std::chrono::year_month_day>(a, 0);
+        auto symbols = cache.get<std::string>(a, 2);
+        auto as_text = cache.get<std::string>(a, 1);
+        using namespace std::chrono;
+        if (dates && symbols && as_text && (*dates)->values[4999] == 2024y / January / 5 &&
+            (*symbols)->values[3] == "S3" && (*as_text)->values[0] == "0.5" &&
+            cache.entries() == 4) {
+            PASS();
+        } else {
+            FAIL("entries=" << cache.entries());
+        }
+    }
+
+    TEST("modified file is reparsed");
+    {
+        write(a, 5000, 3);
+        std::filesystem::last_write_time(
+            a, std::filesystem::last_write_time(a) + std::chrono::seconds(2));
+        auto fresh = cache.get<double>(a, 1);
+        if (fresh && (*fresh)->values[10] == 30.5 && cache.misses() == 5) {
+            PASS();
+        } else {
+            FAIL("value=" << (fresh ? (*fresh)->values[10] : -1));
+        }
+    }
+
+    TEST("budget evicts least recently used");
+    {
+        auto probe = cache.get<double>(b, 1);
+        const size_t one = (*probe)->bytes();
+        blazecsv::ColumnCache small(2 * one + one / 2);
+        auto pa = small.get<double>(a, 1);
+        auto pb = small.get<double>(b, 1);
+        (void)small.get<double>(a, 1);  // a becomes most recent
+        (void)small.get<int64_t>(b, 1);  // Evicts b as double
+        (void)small.get<double>(a, 1);
+        size_t hits_before = small.hits();
+        (void)small.get<double>(b, 1);
+        if (small.memory_used() <= small.budget() && small.entries() == 2 &&
+            small.hits() == hits_before && pb && (*pb)->values[1] == 2.5) {
+            PASS();
+        } else {
+            FAIL("used=" << small.memory_used() << " entries=" << small.entries());
+        }
+    }
+
+    TEST("missing file");
+    {
+        auto missing = cache.get<double>(temp_path("no_such_blazecsv_cache.csv"), 0);
+        if (!missing && missing.error() == blazecsv::ErrorCode::FileOpenError) {
+            PASS();
+        } else {
+            FAIL("expected FileOpenError");
+        }
+    }
+
+#if defined(__linux__)
+    TEST("unreadable file is an error and is not cached");
+    {
+        // stat() succeeds, but the attribute is write-only: open(O_RDONLY) fails, even as root
+        const std::string path = "/sys/bus/pci/rescan";
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec)) {
+            PASS();  // No PCI bus here
+        } else {
+            const size_t entries = cache.entries();
+            const size_t misses = cache.misses();
+            auto first = cache.get<int64_t>(path, 0);
+            auto second = cache.get<int64_t>(path, 0);
+            if (!first && first.error() == blazecsv::ErrorCode::FileOpenError && !second &&
+                cache.entries() == entries && cache.misses() == misses + 2) {
+                PASS();
+            } else {
+                FAIL("expected FileOpenError twice, entries=" << cache.entries());
+            }
+        }
+    }
+#endif
+
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+}
+
+// =============================================================================
+// PARTITION BY
+// =============================================================================
+
+void test_partition_by() {
+    std::cout << "\n=== Partition By ===\n";
+
+    const std::filesystem::path dir = temp_path("test_io_partitions");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const std::string csv = temp_path("test_io_partition.csv");
+
+    // Expected contents per symbol, in file order
+    std::map<std::string, std::string> expected;
+    {
+        std::ofstream f(csv);
+        f << "date,symbol,price\n";
+        for (int i = 0; i < 20000; ++i) {
+            std::string symbol = "S" + std::to_string(i * 7 % 50);
+            std::string row = "2024-01-02," + symbol + "," + std::to_string(i) + "\n";
+            f << row;
+            expected[symbol] += row;
+        }
+        f << "orphan\n";  // No key column: skipped
+        // Keys that would clash under lossy sanitizing, each to its own file
+        const std::pair<std::string, std::string> escaped[] = {
+            {"a/b", "a%2Fb"}, {"a_b", "a_b"}, {"a%2Fb", "a%252Fb"}, {"", "%"},
+            {".", "%2E"},     {"..", "%2E%2E"}, {"_", "_"}};
+        for (const auto& [key, name] : escaped) {
+            f << "2024-01-03," << key << ",1\n";
+            expected[name] += "2024-01-03," + key + ",1\n";
+        }
+        f << "2024-01-03,../x,1";  // Escaped key, no trailing newline
+        expected["..%2Fx"] += "2024-01-03,../x,1\n";
+    }
+    const std::string pattern = (dir / "part_{}.csv").string();
+    auto file_of = [&](const std::string& key) {
+        return (dir / ("part_" + key + ".csv")).string();
+    };
+
+    blazecsv::PartitionOptions options;
+    options.max_open_files = 8;
+    options.flush_bytes = 512;
+
+    TEST("one thread keeps file order, bounded fds");
+    {
+        blazecsv::ParallelReader<3> reader(csv, 1);
+        auto stats = blazecsv::partition_by(reader, 1, pattern, options);
+        bool ok = stats && stats->rows == 20008 && stats->skipped == 1 &&
+                  stats->partitions == 58 && stats->opens > stats->partitions &&
+                  std::distance(std::filesystem::directory_iterator(dir),
+                                std::filesystem::directory_iterator()) == 58;
+        for (const auto& [key, rows] : expected)
+            ok = ok && slurp(file_of(key)) == "date,symbol,price\n" + rows;
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("rows=" << (stats ? stats->rows : 0)
+                         << " partitions=" << (stats ? stats->partitions : 0));
+        }
+    }
+
+    TEST("parallel run writes the same rows per partition");
+    {
+        options.worker_buffer_bytes = 4096;  // Force flush-all cycles too
+        blazecsv::ParallelReader<3> reader(csv, 4);
+        auto stats = blazecsv::partition_by(reader, 1, pattern, options);
+        auto sorted_lines = [](const std::string& text) {
+            std::vector<std::string> lines;
+            std::istringstream in(text);
+            for (std::string line; std::getline(in, line);)
+                lines.push_back(line);
+            if (!lines.empty())
+                std::sort(lines.begin() + 1, lines.end());  // Header stays first
+            return lines;
+        };
+        bool ok = stats && stats->rows == 20008 && stats->partitions == 58;
+        for (const auto& [key, rows] : expected)
+            ok = ok && sorted_lines(slurp(file_of(key))) ==
+                           sorted_lines("date,symbol,price\n" + rows);
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("partitions differ");
+        }
+    }
+
+    TEST("unwritable pattern reports FileOpenError");
+    {
+        blazecsv::ParallelReader<3> reader(csv, 2);
+        auto stats = blazecsv::partition_by(reader, 1, (dir / "missing" / "{}.csv").string());
+        if (!stats && stats.error() == blazecsv::ErrorCode::FileOpenError) {
+            PASS();
+        } else {
+            FAIL("expected FileOpenError");
+        }
+    }
+
+    std::remove(csv.c_str());
+    std::filesystem::remove_all(dir);
+}
+
+// =============================================================================
+// INCREMENTAL SCAN
+// =============================================================================
+
+void test_incremental_scan() {
+    std::cout << "\n=== Incremental Scan ===\n";
+
+    const std::string csv = temp_path("test_io_incremental.csv");
+    const std::string checkpoint = temp_path("test_io_incremental.ckpt");
+    std::remove(checkpoint.c_str());
+    auto append = [&](const std::string& text) {
+        std::ofstream f(csv, std::ios::app | std::ios::binary);
+        f << text;
+    };
+    {
+        std::ofstream f(csv, std::ios::binary);
+        f << "symbol,qty\n";
+    }
+    for (int i = 0; i < 1000; ++i) {
+        std::string row = "S";
+        row.append(std::to_string(i % 3)).append(",").append(std::to_string(i % 10)) += '\n';
+        append(row);
+    }
+
+    using Volumes = std::map<std::string, int64_t>;
+    struct Scan {
+        blazecsv::IncrementalScan<2> scan;
+        blazecsv::ScanResult<int64_t> total;
+        blazecsv::ScanResult<Volumes> by_symbol;
+
+        explicit Scan(const std::string& csv, const std::string& checkpoint)
+            : scan(csv, checkpoint),
+              total(scan.add_reducer(int64_t{0},
+                                     [](int64_t& t, const auto& row) {
+                                         t += row[1].template value_or<int64_t>(0);
+                                     })),
+              by_symbol(scan.add_reducer(
+                  Volumes{},
+                  [](Volumes& v, const auto& row) {
+                      v[std::string(row[0].view())] += row[1].template value_or<int64_t>(0);
+                  },
+                  [](const Volumes& v, std::string& out) {
+                      for (const auto& [k, n] : v)
+                          out += k + "=" + std::to_string(n) + "\n";
+                  },
+                  [](Volumes& v, std::string_view in) {
+                      std::istringstream lines{std::string(in)};
+                      for (std::string line; std::getline(lines, line);) {
+                          size_t eq = line.find('=');
+                          if (eq == std::string::npos)
+                              return false;
+                          v[line.substr(0, eq)] = std::stoll(line.substr(eq + 1));
+                      }
+                      return true;
+                  })) {}
+    };
+
+    TEST("refresh parses only appended complete lines");
+    {
+        Scan s(csv, checkpoint);
+        auto first = s.scan.refresh();
+        append("S0,7\nS1,");  // Unterminated tail waits
+        auto second = s.scan.refresh();
+        append("3\n");
+        auto third = s.scan.refresh();
+        auto idle = s.scan.refresh();
+        if (first && *first == 1000 && second && *second == 1 && third && *third == 1 && idle &&
+            *idle == 0 && *s.total == 4500 + 10 && s.by_symbol->at("S1") == 1497 + 3 &&
+            s.scan.rows() == 1002 && s.scan.offset() == std::filesystem::file_size(csv)) {
+            PASS();
+        } else {
+            FAIL("total=" << *s.total << " rows=" << s.scan.rows());
+        }
+    }
+
+    TEST("restart resumes from the checkpoint");
+    {
+        append("S2,100\n");
+        Scan s(csv, checkpoint);
+        auto r = s.scan.refresh();
+        if (r && *r == 1 && *s.total == 4610 && s.by_symbol->at("S2") == 1500 + 100 &&
+            s.scan.rows() == 1003) {
+            PASS();
+        } else {
+            FAIL("r=" << (r ? *r : 0) << " total=" << *s.total);
+        }
+    }
+
+    TEST("replaced file starts over");
+    {
+        {
+            std::ofstream f(csv, std::ios::binary);
+            f << "symbol,qty\nS9,1\nS9,2\n";
+        }
+        Scan s(csv, checkpoint);
+        auto r = s.scan.refresh();
+        if (r && *r == 2 && *s.total == 3 && s.by_symbol->size() == 1 && s.scan.rows() == 2) {
+            PASS();
+        } else {
+            FAIL("total=" << *s.total);
+        }
+    }
+
+    TEST("checkpoint for other reducers is ignored");
+    {
+        blazecsv::IncrementalScan<2> scan(csv, checkpoint);
+        auto count = scan.add_reducer(size_t{0}, [](size_t& n, const auto&) { ++n; });
+        auto r = scan.refresh();
+        if (r && *r == 2 && *count == 2) {
+            PASS();
+        } else {
+            FAIL("count=" << *count);
+        }
+    }
+
+    std::remove(csv.c_str());
+    std::remove(checkpoint.c_str());
+}
+
+// =============================================================================
+// STREAMING PARALLEL READER
+// =============================================================================
+
+void test_streaming_reader() {
+    std::cout << "\n=== Streaming Parallel Reader ===\n";
+
+    // Rows of varying length, CRLF mixed in, one line longer than a block
+    std::string text = "id,tag,value\n";
+    int64_t expected_sum = 0;
+    for (int i = 0; i < 50000; ++i) {
+        std::string tag = i == 30000 ? std::string(10000, 't') : std::string(i % 13, 'x');
+        text += std::to_string(i) + "," + tag + "," + std::to_string(i % 100) +
+                (i % 4 ? "\n" : "\r\n");
+        expected_sum += i % 100;
+    }
+    text += "50000,end,7";  // No trailing newline
+    expected_sum += 7;
+    const std::string filename = temp_path("test_io_stream.csv");
+    {
+        std::ofstream f(filename, std::ios::binary);
+        f << text;
+    }
+
+    TEST("FILE* input, unordered");
+    {
+        std::FILE* in = std::fopen(filename.c_str(), "rb");
+        blazecsv::StreamingParallelReader<3> reader(in, 3, true, 4096);
+        std::atomic<int64_t> sum{0};
+        size_t rows = reader.for_each_parallel(
+            [&](const auto& f) { sum.fetch_add(f[2].template value_or<int64_t>(0)); });
+        size_t again = reader.for_each_parallel([](const auto&) {});
+        std::fclose(in);
+        if (rows == 50001 && sum == expected_sum && again == 0 && reader.headers()[2] == "value") {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " sum=" << sum.load());
+        }
+    }
+
+    TEST("in-order delivery");
+    {
+        std::FILE* in = std::fopen(filename.c_str(), "rb");
+        blazecsv::StreamingParallelReader<3> reader(in, 4, true, 4096);
+        int64_t last = -1;
+        bool ordered = true;
+        size_t rows = reader.for_each_ordered([&](const auto& f) {
+            int64_t id = f[0].template value_or<int64_t>(-2);
+            ordered = ordered && id == last + 1;
+            last = id;
+        });
+        std::fclose(in);
+        if (rows == 50001 && ordered && last == 50000) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " last=" << last);
+        }
+    }
+
+#if !defined(_WIN32)
+    TEST("pipe fed in small writes");
+    {
+        int fds[2];
+        bool ok = ::pipe(fds) == 0;
+        std::thread producer([&] {
+            for (size_t pos = 0; ok && pos < text.size();) {
+                size_t n = std::min<size_t>(text.size() - pos, 1 + pos % 3000);
+                ssize_t put = ::write(fds[1], text.data() + pos, n);
+                if (put <= 0)
+                    break;
+                pos += static_cast<size_t>(put);
+            }
+            ::close(fds[1]);
+        });
+        blazecsv::StreamingParallelReader<3> reader(fds[0], 2);
+        std::atomic<int64_t> sum{0};
+        size_t rows = reader.for_each_parallel(
+            [&](const auto& f) { sum.fetch_add(f[2].template value_or<int64_t>(0)); });
+        producer.join();
+        ::close(fds[0]);
+        if (ok && rows == 50001 && sum == expected_sum) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows);
+        }
+    }
+#endif
+
+    TEST("empty and header-only input");
+    {
+        std::string header_only = "id,tag,value\n";
+        size_t pos = 0;
+        blazecsv::StreamingParallelReader<3> header(
+            [&](char* out, size_t n) {
+                n = std::min(n, header_only.size() - pos);
+                std::memcpy(out, header_only.data() + pos, n);
+                pos += n;
+                return n;
+            },
+            2);
+        blazecsv::StreamingParallelReader<3> empty([](char*, size_t) { return size_t{0}; }, 2);
+        if (header.for_each_ordered([](const auto&) {}) == 0 && header.headers()[0] == "id" &&
+            empty.for_each_parallel([](const auto&) {}) == 0) {
+            PASS();
+        } else {
+            FAIL("expected no rows");
+        }
+    }
+
+    TEST("read failure partway is reported, not EOF");
+    {
+        // Serves 100000 bytes in 1000-byte reads, then fails mid-line
+        size_t pos = 0;
+        const size_t fail_at = 100000;
+        auto failing = [&](char* out, size_t n) -> std::expected<size_t, blazecsv::ErrorCode> {
+            if (pos >= fail_at)
+                return std::unexpected(blazecsv::ErrorCode::ReadError);
+            n = std::min({n, size_t{1000}, fail_at - pos});
+            std::memcpy(out, text.data() + pos, n);
+            pos += n;
+            return n;
+        };
+        // Complete rows before the failure: every newline but the header's
+        const size_t complete = std::count(text.begin(), text.begin() + fail_at, '\n') - 1;
+        blazecsv::StreamingParallelReader<3> reader(failing, 3, true, 4096);
+        size_t rows = reader.for_each_ordered([](const auto&) {});
+        if (rows == complete && text[fail_at - 1] != '\n' &&
+            reader.error() == blazecsv::ErrorCode::ReadError) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows << " expected " << complete);
+        }
+    }
+
+#if !defined(_WIN32)
+    TEST("fd read error is reported");
+    {
+        int fd = ::open(std::filesystem::temp_directory_path().c_str(), O_RDONLY);
+        blazecsv::StreamingParallelReader<3> reader(fd, 2);  // read() fails with EISDIR
+        size_t rows = reader.for_each_parallel([](const auto&) {});
+        if (fd >= 0)
+            ::close(fd);
+        blazecsv::StreamingParallelReader<3> ok_reader([](char*, size_t) { return size_t{0}; }, 1);
+        if (fd >= 0 && rows == 0 && reader.error() == blazecsv::ErrorCode::ReadError &&
+            ok_reader.error() == blazecsv::ErrorCode::Ok) {
+            PASS();
+        } else {
+            FAIL("fd=" << fd << " rows=" << rows);
+        }
+    }
+#endif
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// JSON OUTPUT
+// =============================================================================
+
+void test_json_output() {
+    std::cout << "\n=== JSON Output ===\n";
+
+    const std::string csv = temp_path("test_io_json.csv");
+    const std::string out = temp_path("test_io_json.ndjson");
+    auto write = [](const std::string& path, const std::string& text) {
+        std::ofstream f(path, std::ios::binary);
+        f << text;
+    };
+    auto read = [](const std::string& path) {
+        std::ifstream f(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(f), {});
+    };
+
+    TEST("escaping across SIMD blocks");
+    {
+        // Specials at every offset of a 16-byte block, plus UTF-8 passed through
+        std::string expected;
+        bool ok = true;
+        for (size_t at = 0; at < 40; ++at) {
+            for (char special : {'"', '\\', '\x01', '\x1f'}) {
+                std::string s(40, 'a');
+                s[at] = special;
+                std::string json;
+                blazecsv::detail::append_json_string(json, s);
+                std::string escape = special == '"'    ? "\\\""
+                                     : special == '\\' ? "\\\\"
+                                     : special == 1    ? "\\u0001"
+                                                       : "\\u001f";
+                std::string want = "\"";
+                want.append(at, 'a').append(escape).append(39 - at, 'a') += '"';
+                ok &= json == want;
+            }
+        }
+        std::string json;
+        blazecsv::detail::append_json_string(json, "t\tn\nr\rb\bf\f caf\xc3\xa9 \x7f");
+        if (ok && json == "\"t\\tn\\nr\\rb\\bf\\f caf\xc3\xa9 \x7f\"") {
+            PASS();
+        } else {
+            FAIL(json);
+        }
+    }
+
+    TEST("number grammar");
+    {
+        using blazecsv::detail::is_json_number;
+        bool ok = is_json_number("0") && is_json_number("-12") && is_json_number("3.25") &&
+                  is_json_number("1e9") && is_json_number("-0.5E-3");
+        for (std::string_view bad : {"", "-", "01", "1.", ".5", "1e", "+1", "0x10", "NaN", "1 "})
+            ok &= !is_json_number(bad);
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("grammar mismatch");
+        }
+    }
+
+    TEST("inferred types and nulls");
+    {
+        write(csv, "id,name,price,active,note\r\n"
+                   "1,\"Bob\",9.5,TRUE,\n"
+                   "2,a\\b,,false,x\n"
+                   "3,only,two\n"
+                   "4,c,1e3,,\n");
+        auto rows = blazecsv::csv_to_ndjson(csv, out);
+        std::string expected =
+            "{\"id\":1,\"name\":\"\\\"Bob\\\"\",\"price\":9.5,\"active\":true,\"note\":\"\"}\n"
+            "{\"id\":2,\"name\":\"a\\\\b\",\"price\":null,\"active\":false,\"note\":\"x\"}\n"
+            "{\"id\":4,\"name\":\"c\",\"price\":1e3,\"active\":null,\"note\":\"\"}\n";
+        std::string got = read(out);
+        if (rows && *rows == 3 && got == expected) {
+            PASS();
+        } else {
+            FAIL(got);
+        }
+    }
+
+    TEST("declared types and array mode");
+    {
+        write(csv, "zip,count\n02134,7\nn/a,8\n");
+        blazecsv::JsonOptions options;
+        options.types = {blazecsv::JsonType::Number};
+        options.array = true;
+        auto rows = blazecsv::csv_to_ndjson(csv, out, options);
+        std::string got = read(out);
+        // Leading zeros are not JSON numbers, so the value stays a string
+        if (rows && *rows == 2 &&
+            got == "[\n{\"zip\":\"02134\",\"count\":7},\n{\"zip\":\"n/a\",\"count\":8}\n]\n") {
+            PASS();
+        } else {
+            FAIL(got);
+        }
+    }
+
+    TEST("ordered parallel output");
+    {
+        std::string text = "seq,label\n";
+        std::string expected = "[\n";
+        for (int i = 0; i < 20000; ++i) {
+            std::string label = "row \"" + std::to_string(i) + "\"";
+            text += std::to_string(i) + "," + label + (i % 3 ? "\n" : "\r\n");
+            expected += (i ? ",\n" : "") + std::string("{\"seq\":") + std::to_string(i) +
+                        ",\"label\":\"row \\\"" + std::to_string(i) + "\\\"\"}";
+        }
+        expected += "\n]\n";
+        write(csv, text);
+        blazecsv::JsonOptions options;
+        options.num_threads = 4;
+        options.array = true;
+        options.morsel_bytes = 4096;
+        auto rows = blazecsv::csv_to_ndjson(csv, out, options);
+        std::string got = read(out);
+        if (rows && *rows == 20000 && got == expected) {
+            PASS();
+        } else {
+            FAIL("rows=" << (rows ? *rows : 0) << " bytes=" << got.size());
+        }
+    }
+
+    TEST("empty input and errors");
+    {
+        write(csv, "a,b\n");
+        blazecsv::JsonOptions options;
+        options.array = true;
+        auto rows = blazecsv::csv_to_ndjson(csv, out, options);
+        auto missing = blazecsv::csv_to_ndjson(temp_path("test_io_json_missing.csv"), out);
+        if (rows && *rows == 0 && read(out) == "[\n]\n" && !missing &&
+            missing.error() == blazecsv::ErrorCode::FileOpenError) {
+            PASS();
+        } else {
+            FAIL("unexpected result");
+        }
+    }
+
+    std::remove(csv.c_str());
+    std::remove(out.c_str());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main() {
+    std::cout << "=== BlazeCSV I/O Tests ===\n";
+
+    test_file_source();
+    test_mapped_file_cache();
+    test_streaming_reader();
+    test_file_batch_source();
+    test_writer();
+    test_hash_index();
+    test_column_cache();
+    test_partition_by();
+    test_incremental_scan();
+    test_json_output();
+#ifdef BLAZECSV_WITH_ZLIB
+    test_gzip_index();
+#endif
+
+    std::cout << "\n=== Summary ===\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests passed: " << tests_passed << "\n";
+    std::cout << "Tests failed: " << (tests_run - tests_passed) << "\n";
+
+    return tests_run == tests_passed ? 0 : 1;
+}
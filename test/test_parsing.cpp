@@ -9,6 +9,8 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
+#include <mutex>
 
 // Cross-platform temp file path
 inline std::string temp_path(const std::string& name) {
@@ -314,6 +316,172 @@ void test_string_parsing() {
     std::remove(filename.c_str());
 }
 
+void test_allocator_aware_strings() {
+    std::cout << "\n=== Allocator-Aware Strings ===\n";
+
+    const std::string filename = temp_path("test_pmr_string.csv");
+    {
+        std::ofstream f(filename);
+        f << "id,name\n";
+        for (int i = 0; i < 1000; ++i) {
+            f << i << ",a_string_that_is_longer_than_small_string_optimization_" << i << "\n";
+        }
+    }
+
+    TEST("parse<std::pmr::string> uses the given resource");
+    {
+        std::array<std::byte, 4096> buffer;
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                                  std::pmr::null_memory_resource());
+        blazecsv::TurboReader<2> reader(filename);
+        std::pmr::string first(&arena);
+        reader.for_each_until([&](const auto& fields) {
+            first = *fields[1].template parse<std::pmr::string>(&arena);
+            return false;
+        });
+        if (first == "a_string_that_is_longer_than_small_string_optimization_0" &&
+            first.get_allocator().resource() == &arena) {
+            PASS();
+        } else {
+            FAIL("got '" << first << "'");
+        }
+    }
+
+    TEST("intern_copy outlives the reader");
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        std::vector<std::string_view> names;
+        {
+            blazecsv::TurboReader<2> reader(filename);
+            reader.for_each(
+                [&](const auto& fields) { names.push_back(fields[1].intern_copy(arena)); });
+        }
+        if (names.size() == 1000 &&
+            names[999] == "a_string_that_is_longer_than_small_string_optimization_999") {
+            PASS();
+        } else {
+            FAIL("interned views wrong");
+        }
+    }
+
+    TEST("intern_copy of empty field");
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        blazecsv::FieldRef empty;
+        if (empty.intern_copy(arena).empty()) {
+            PASS();
+        } else {
+            FAIL("expected empty view");
+        }
+    }
+
+    TEST("per-worker arenas in ParallelReader");
+    {
+        blazecsv::ParallelReader<2> reader(filename, 4);
+        std::mutex mutex;
+        std::vector<std::string_view> names;
+        size_t rows = reader.for_each_parallel_with_arena(
+            [&](const auto& fields, std::pmr::memory_resource& arena) {
+                std::string_view name = fields[1].intern_copy(arena);
+                std::lock_guard lock(mutex);
+                names.push_back(name);
+            });
+        size_t total_len = 0;
+        for (auto n : names)
+            total_len += n.size();
+        bool owned = !names.empty() && names[0].data() != nullptr;
+        if (rows == 1000 && names.size() == 1000 && total_len > 1000 * 56 && owned) {
+            PASS();
+        } else {
+            FAIL("rows=" << rows);
+        }
+        reader.release_arenas();
+    }
+
+    std::remove(filename.c_str());
+}
+
+void test_memoized_parsing() {
+    std::cout << "\n=== Memoized Parsing ===\n";
+
+    const std::string filename = temp_path("test_memo.csv");
+    {
+        std::ofstream f(filename);
+        f << "date,symbol,qty\n";
+        for (int i = 0; i < 300; ++i) {
+            f << (i < 150 ? "2024-03-01" : "2024-03-02") << ","
+              << (i % 100 < 50 ? "AAPL" : "MSFT") << "," << (i / 10) << "\n";
+        }
+        f << "bad-date,AAPL,1\n";
+        f << "bad-date,AAPL,1\n";
+    }
+
+    blazecsv::TurboReader<3> reader(filename);
+    blazecsv::FieldMemo<std::chrono::year_month_day> date_memo;
+    blazecsv::FieldMemo<int> qty_memo;
+    blazecsv::FieldMemo<std::string> symbol_memo;
+    std::vector<std::expected<std::chrono::year_month_day, blazecsv::ErrorCode>> dates;
+    int64_t qty_sum = 0;
+    size_t aapl = 0;
+
+    reader.for_each([&](const auto& fields) {
+        dates.push_back(date_memo.parse(fields[0]));
+        qty_sum += qty_memo.parse(fields[2]).value_or(0);
+        aapl += symbol_memo.parse(fields[1]).value_or("") == "AAPL";
+    });
+
+    TEST("memoized values match direct parsing");
+    {
+        using namespace std::chrono;
+        int64_t expected_sum = 0;
+        for (int i = 0; i < 300; ++i)
+            expected_sum += i / 10;
+        expected_sum += 2;
+        if (dates.size() == 302 && dates[0] && *dates[0] == year{2024} / 3 / 1 && dates[299] &&
+            *dates[299] == year{2024} / 3 / 2 && qty_sum == expected_sum && aapl == 152) {
+            PASS();
+        } else {
+            FAIL("values mismatch");
+        }
+    }
+
+    TEST("runs are served from the memo");
+    if (date_memo.hits() == 299 && qty_memo.hits() == 302 - 31) {
+        PASS();
+    } else {
+        FAIL("date hits=" << date_memo.hits() << " qty hits=" << qty_memo.hits());
+    }
+
+    TEST("errors are memoized too");
+    if (!dates[300] && !dates[301] && dates[301].error() == blazecsv::ErrorCode::InvalidDate) {
+        PASS();
+    } else {
+        FAIL("expected InvalidDate");
+    }
+
+    TEST("custom conversion and long fields");
+    {
+        blazecsv::FieldMemo<size_t> memo;
+        std::string long_value(100, 'x');
+        blazecsv::FieldRef f(long_value.data(), long_value.data() + long_value.size());
+        size_t calls = 0;
+        auto convert = [&](const blazecsv::FieldRef& field)
+            -> std::expected<size_t, blazecsv::ErrorCode> {
+            ++calls;
+            return field.size();
+        };
+        memo.get(f, convert);
+        memo.get(f, convert);
+        if (calls == 2 && *memo.get(f, convert) == 100 && memo.hits() == 0) {
+            PASS();
+        } else {
+            FAIL("long fields should not be memoized");
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
 void test_tsv_parsing() {
     std::cout << "\n=== TSV Parsing ===\n";
 
@@ -377,6 +545,273 @@ void test_header_access() {
     std::remove(filename.c_str());
 }
 
+void test_single_record() {
+    std::cout << "\n=== Single Record Parsing ===\n";
+
+    TEST("quote record");
+    {
+        auto r = blazecsv::parse_record<5>("AAPL,189.25,189.27,300,1700000000123456789\n");
+        if (r && (*r)[0].view() == "AAPL" && (*r)[1].value_or(0.0) == 189.25 &&
+            (*r)[3].value_or(0) == 300 &&
+            (*r)[4].value_or(int64_t{0}) == int64_t{1700000000123456789}) {
+            PASS();
+        } else {
+            FAIL("bad fields");
+        }
+    }
+
+    TEST("fields across 16-byte blocks, CRLF");
+    {
+        std::string rec;
+        auto field = [](int i) {
+            return std::string(static_cast<size_t>(i % 5), 'x') + std::to_string(i);
+        };
+        for (int i = 0; i < 12; ++i) {
+            rec += i ? "," : "";
+            rec += field(i);
+        }
+        rec += "\r\n";
+        auto r = blazecsv::parse_record<12>(rec);
+        bool ok = r.has_value();
+        for (int i = 0; ok && i < 12; ++i)
+            ok = (*r)[i].view() == field(i);
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("mismatch in '" << rec << "'");
+        }
+    }
+
+    TEST("empty fields");
+    {
+        auto r = blazecsv::parse_record<4>(",,x,");
+        auto one = blazecsv::parse_record<1>("");
+        if (r && (*r)[0].empty() && (*r)[1].empty() && (*r)[2].view() == "x" && (*r)[3].empty() &&
+            one && (*one)[0].empty()) {
+            PASS();
+        } else {
+            FAIL("bad empty handling");
+        }
+    }
+
+    TEST("wrong field count");
+    {
+        auto few = blazecsv::parse_record<3>("a,b");
+        auto many = blazecsv::parse_record<3>("a,b,c,d");
+        auto many_long = blazecsv::parse_record<2>("aaaaaaaaaaaaaaaa,bbbbbbbbbbbbbbbbbbbb,c");
+        auto single = blazecsv::parse_record<1>("abcdefghijklmnopqrstuvwxyz\r\n");
+        auto single_split = blazecsv::parse_record<1>("abcdefghijklmnopq,rs");
+        if (!few && few.error() == blazecsv::ErrorCode::ColumnCountMismatch && !many &&
+            !many_long && single && (*single)[0].view() == "abcdefghijklmnopqrstuvwxyz" &&
+            !single_split && single_split.error() == blazecsv::ErrorCode::ColumnCountMismatch) {
+            PASS();
+        } else {
+            FAIL("expected ColumnCountMismatch");
+        }
+    }
+
+    TEST("custom delimiter");
+    {
+        auto r = blazecsv::parse_record<3, '\t'>("a,b\tc\td");
+        if (r && (*r)[0].view() == "a,b" && (*r)[2].view() == "d") {
+            PASS();
+        } else {
+            FAIL("bad TSV record");
+        }
+    }
+}
+
+enum class Side : uint8_t { Buy, Sell, Short };
+enum class Venue : uint16_t { V0 };  // Values cast from indices below
+
+template <>
+struct blazecsv::enum_table<Side> {
+    static constexpr std::pair<std::string_view, Side> entries[] = {
+        {"BUY", Side::Buy}, {"SELL", Side::Sell}, {"SELL_SHORT", Side::Short}};
+};
+
+// Names of 1 to 27 bytes, several sharing prefixes and suffixes,
+// and longer pairs that differ only past the first and last 8 bytes
+constexpr std::string_view VENUE_NAMES[] = {
+    "X",        "XN",       "XNY",        "XNYS",        "XNAS",         "ARCA",
+    "BATS",     "IEX",      "EDGX",       "EDGA",        "NYSEARCA",     "NYSEAMEX",
+    "NASDAQ",   "NASDAQBX", "NASDAQPSX",  "CBOE",        "CBOEBYX",      "CBOEBZX",
+    "MEMX",     "LTSE",     "MIAX_PEARL", "LONDON_STOCK_EXCHANGE",
+    "TOKYO_STOCK_EXCHANGE",   "HONG_KONG_EXCHANGES_24",
+    "venue:XNYS:primary",     "venue:XNAS:primary",
+    "venue:XNYS:primary:odd_lots", "venue:XNYS:backup_:odd_lots"};
+
+template <>
+struct blazecsv::enum_table<Venue> {
+    static constexpr auto entries = [] {
+        std::array<std::pair<std::string_view, Venue>, std::size(VENUE_NAMES)> table{};
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = {VENUE_NAMES[i], static_cast<Venue>(i)};
+        return table;
+    }();
+};
+
+void test_enum_parsing() {
+    std::cout << "\n=== Enum Parsing ===\n";
+
+    auto field = [](std::string_view s) {
+        return blazecsv::FieldRef(s.data(), s.data() + s.size());
+    };
+
+    TEST("small table");
+    {
+        std::string buy = "BUY", sell = "SELL", shrt = "SELL_SHORT";
+        auto bad = field("buy").parse_enum<Side>();
+        if (field(buy).parse_enum<Side>() == Side::Buy &&
+            field(sell).parse_enum<Side>() == Side::Sell &&
+            field(shrt).parse_enum<Side>() == Side::Short && !bad &&
+            bad.error() == blazecsv::ErrorCode::InvalidEnum && !field("").parse_enum<Side>() &&
+            !field("SELL_").parse_enum<Side>() && !field("SEL").parse_enum<Side>()) {
+            PASS();
+        } else {
+            FAIL("wrong mapping");
+        }
+    }
+
+    TEST("every name maps, near misses do not");
+    {
+        bool ok = true;
+        for (size_t i = 0; i < std::size(VENUE_NAMES); ++i) {
+            std::string name(VENUE_NAMES[i]);
+            auto hit = field(name).parse_enum<Venue>();
+            ok &= hit && *hit == static_cast<Venue>(i);
+            // Flip each byte, drop the last, append one
+            for (size_t j = 0; j < name.size(); ++j) {
+                std::string miss = name;
+                miss[j] ^= 0x20;
+                ok &= !field(miss).parse_enum<Venue>();
+            }
+            std::string_view shorter = std::string_view(name).substr(0, name.size() - 1);
+            auto prefix = field(shorter).parse_enum<Venue>();  // Only hits if itself a name
+            ok &= !prefix || VENUE_NAMES[static_cast<size_t>(*prefix)] == shorter;
+            ok &= !field(name + "Z").parse_enum<Venue>();
+        }
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("lookup mismatch");
+        }
+    }
+
+    TEST("columns from a file");
+    {
+        const std::string filename = temp_path("test_enum.csv");
+        {
+            std::ofstream f(filename);
+            f << "id,side,venue\n1,BUY,XNYS\n2,SELL,IEX\n3,HOLD,XNYS\n4,SELL_SHORT,MIAX_PEARL\n";
+        }
+        blazecsv::TurboReader<3> reader(filename);
+        int buys = 0, sells = 0, invalid = 0, xnys = 0;
+        reader.for_each([&](const auto& f) {
+            auto side = f[1].template parse_enum<Side>();
+            if (!side)
+                ++invalid;
+            else if (*side == Side::Buy)
+                ++buys;
+            else
+                ++sells;
+            xnys += f[2].template parse_enum<Venue>() == static_cast<Venue>(3);
+        });
+        std::remove(filename.c_str());
+        if (buys == 1 && sells == 2 && invalid == 1 && xnys == 2) {
+            PASS();
+        } else {
+            FAIL("buys=" << buys << " sells=" << sells << " invalid=" << invalid);
+        }
+    }
+}
+
+void test_tag_value() {
+    std::cout << "\n=== Tag=Value Messages ===\n";
+
+    TEST("SOH message lookups");
+    {
+        blazecsv::TagValueMessage<> msg;
+        std::string text = "8=FIX.4.4\x01" "9=65\x01" "35=D\x01" "44=101.25\x01" "38=300\x01"
+                           "58=a=b\x01" "10=123\x01";
+        auto n = msg.parse(text);
+        if (n && *n == 7 && msg.get(35)->view() == "D" && msg.get(44)->value_or(0.0) == 101.25 &&
+            msg.get(38)->value_or(0) == 300 && msg.get(58)->view() == "a=b" && !msg.get(11) &&
+            msg.has(10)) {
+            PASS();
+        } else {
+            FAIL("bad lookups");
+        }
+    }
+
+    TEST("pipe separator, repeating group, many tags");
+    {
+        blazecsv::TagValueMessage<'|'> msg;
+        std::string text = "35=W|268=2|269=0|270=1.5|269=1|270=1.6|";
+        for (int tag = 1000; tag < 1100; ++tag)
+            text += std::to_string(tag) + "=v" + std::to_string(tag) + "|";
+        text += "\r\n";
+        auto n = msg.parse(text);
+        size_t sides = 0;
+        for (const auto& field : msg.fields())
+            sides += field.tag == 269;
+        bool ok = n && *n == 106 && sides == 2 && msg.get(269)->view() == "0" &&
+                  msg.get(270)->view() == "1.5";
+        for (int tag = 1000; ok && tag < 1100; ++tag)
+            ok = msg.get(tag)->view().substr(0, 1) == "v" &&
+                 msg.get(tag)->view().substr(1) == std::to_string(tag);
+        if (ok) {
+            PASS();
+        } else {
+            FAIL("bad message");
+        }
+    }
+
+    TEST("malformed pairs");
+    {
+        blazecsv::TagValueMessage<'|'> msg;
+        auto no_eq = msg.parse("35=D|garbage|");
+        auto bad_tag = msg.parse("3x=D|");
+        auto empty = msg.parse("");
+        if (!no_eq && no_eq.error() == blazecsv::ErrorCode::InvalidInteger && !bad_tag &&
+            empty && *empty == 0 && !msg.get(35)) {
+            PASS();
+        } else {
+            FAIL("expected InvalidInteger");
+        }
+    }
+
+    TEST("reader over a log");
+    {
+        const std::string filename = temp_path("test_fix.log");
+        {
+            std::ofstream f(filename, std::ios::binary);
+            for (int i = 0; i < 1000; ++i) {
+                f << "8=FIX.4.4|35=" << (i % 2 ? "D" : "8") << "|38=" << i << "|10=000|\n";
+                if (i == 500)
+                    f << "not a message\n\n";
+            }
+        }
+        blazecsv::TagValueReader<'|'> reader(filename);
+        size_t orders = 0;
+        int64_t qty = 0;
+        size_t n = reader.for_each([&](const auto& msg) {
+            if (msg.get(35)->view() == "D") {
+                ++orders;
+                qty += msg.get(38)->value_or(int64_t{0});
+            }
+        });
+        if (n == 1000 && orders == 500 && qty == 250000 &&
+            reader.last_error().code == blazecsv::ErrorCode::InvalidInteger &&
+            reader.last_error().line == 502) {
+            PASS();
+        } else {
+            FAIL("n=" << n << " orders=" << orders << " line=" << reader.last_error().line);
+        }
+        std::remove(filename.c_str());
+    }
+}
+
 int main() {
     std::cout << "=== BlazeCSV Parsing Tests ===\n";
 
@@ -384,6 +819,11 @@ int main() {
     test_double_parsing();
     test_boolean_parsing();
     test_string_parsing();
+    test_allocator_aware_strings();
+    test_memoized_parsing();
+    test_single_record();
+    test_tag_value();
+    test_enum_parsing();
     test_tsv_parsing();
     test_header_access();
 
@@ -0,0 +1,181 @@
+// BlazeCSV - Tracepoint Tests
+//
+// Builds the library with BLAZECSV_ENABLE_PROBES against the counting
+// <sys/sdt.h> in test/stubs, so the probes-on configuration always compiles
+// and every parallel entry point is checked to fire chunk_start/chunk_end.
+
+#include <blazecsv/blazecsv.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if !BLAZECSV_HAS_PROBES
+#error "test_probes must see test/stubs/sys/sdt.h"
+#endif
+
+// Cross-platform temp file path
+inline std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+#define TEST(name)                       \
+    std::cout << "  " << name << "... "; \
+    tests_run++
+#define PASS()             \
+    std::cout << "PASS\n"; \
+    tests_passed++
+#define FAIL(msg) std::cout << "FAIL: " << msg << "\n"
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Hits of one probe since the last reset(), and the sum of one argument
+struct ProbeCount {
+    size_t hits = 0;
+    uint64_t sum = 0;
+};
+
+static ProbeCount count(const std::string& name, size_t arg = 0) {
+    std::lock_guard lock(sdt_stub::mutex);
+    ProbeCount result;
+    for (const auto& hit : sdt_stub::hits) {
+        if (hit.name == "blazecsv:" + name) {
+            ++result.hits;
+            result.sum += arg < hit.args.size() ? hit.args[arg] : 0;
+        }
+    }
+    return result;
+}
+
+static void reset() {
+    std::lock_guard lock(sdt_stub::mutex);
+    sdt_stub::hits.clear();
+}
+
+// =============================================================================
+// PROBES
+// =============================================================================
+
+void test_probes() {
+    std::cout << "\n=== Probes ===\n";
+
+    const std::string filename = temp_path("test_probes.csv");
+    const size_t total_rows = 20000;
+    {
+        std::ofstream f(filename);
+        f << "id,value,tag\n";
+        for (size_t i = 0; i < total_rows; ++i)
+            f << i << "," << (i % 10) << ",t" << (i % 3) << "\n";
+        f << "bad,row\n";  // Skipped by ParallelReader, an error for CheckedReader
+    }
+
+    TEST("file_open and header");
+    {
+        reset();
+        blazecsv::ParallelReader<3> reader(filename, 4);
+        const ProbeCount opens = count("file_open", 1);
+        const ProbeCount header = count("header", 0);
+        if (opens.hits == 1 && opens.sum == std::filesystem::file_size(filename) &&
+            header.hits == 1 && header.sum == 3) {
+            PASS();
+        } else {
+            FAIL("file_open=" << opens.hits << " header=" << header.hits);
+        }
+    }
+
+    TEST("for_each_parallel chunks report their rows");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 4);
+        reset();
+        size_t rows = reader.for_each_parallel([](const auto&) {});
+        const ProbeCount starts = count("chunk_start", 1);
+        const ProbeCount ends = count("chunk_end", 2);
+        if (rows == total_rows && starts.hits == 4 && ends.hits == 4 && ends.sum == rows &&
+            starts.sum == count("chunk_end", 1).sum) {
+            PASS();
+        } else {
+            FAIL("starts=" << starts.hits << " ends=" << ends.hits << " rows=" << ends.sum);
+        }
+    }
+
+    TEST("for_each_chunk fires once per chunk");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 3);
+        reset();
+        std::atomic<uint64_t> bytes{0};
+        size_t chunks = reader.for_each_chunk([&](size_t, const char* begin, const char* end) {
+            bytes.fetch_add(static_cast<uint64_t>(end - begin));
+        });
+        const ProbeCount starts = count("chunk_start", 1);
+        const ProbeCount ends = count("chunk_end", 2);
+        if (chunks == 3 && starts.hits == 3 && ends.hits == 3 && starts.sum == bytes &&
+            ends.sum == 0) {
+            PASS();
+        } else {
+            FAIL("chunks=" << chunks << " starts=" << starts.hits << " rows=" << ends.sum);
+        }
+    }
+
+    TEST("Validator and SharedScan emit chunk probes");
+    {
+        blazecsv::ParallelReader<3> reader(filename, 4);
+        blazecsv::Validator<3> validator;
+        validator.column(0).type(blazecsv::ColumnType::Integer);
+        reset();
+        auto report = validator.run(reader);
+        const ProbeCount validated = count("chunk_end", 2);
+
+        blazecsv::SharedScan<3> scan(reader);
+        auto sum = scan.add_reducer(
+            int64_t{0},
+            [](int64_t& s, const auto& row) { s += row[1].template value_or<int64_t>(0); },
+            [](int64_t& into, int64_t&& from) { into += from; });
+        reset();
+        size_t scanned = scan.run();
+        const ProbeCount scan_ends = count("chunk_end", 2);
+        const ProbeCount batches = count("batch", 1);
+        if (validated.hits == 4 && validated.sum == report.rows && scan_ends.hits == 4 &&
+            scan_ends.sum == scanned && batches.hits >= 4 && batches.sum == scanned &&
+            scanned == total_rows && *sum > 0) {
+            PASS();
+        } else {
+            FAIL("validator=" << validated.hits << "/" << validated.sum
+                              << " scan=" << scan_ends.hits << "/" << scan_ends.sum);
+        }
+    }
+
+    TEST("error probe on a short row");
+    {
+        blazecsv::CheckedReader<3> reader(filename);
+        reset();
+        reader.for_each([](const auto&) {});
+        const ProbeCount errors = count("error", 2);
+        if (errors.hits == 1 && errors.sum == 2) {
+            PASS();
+        } else {
+            FAIL("errors=" << errors.hits << " columns=" << errors.sum);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main() {
+    std::cout << "=== BlazeCSV Probe Tests ===\n";
+
+    test_probes();
+
+    std::cout << "\n=== Summary ===\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests passed: " << tests_passed << "\n";
+    std::cout << "Tests failed: " << (tests_run - tests_passed) << "\n";
+
+    return tests_run == tests_passed ? 0 : 1;
+}